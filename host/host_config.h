@@ -0,0 +1,340 @@
+#pragma once
+// Kconfig and devicetree defaults for host builds of the mixer.
+// Every value can be overridden from the command line, e.g.
+// -DCONFIG_POINTER_2S_MIXER_FIXED_POINT=1 or -DCONFIG_POINTER_2S_MIXER_FRAME_SYNC=0
+
+#ifndef CONFIG_ZMK_LOG_LEVEL
+#define CONFIG_ZMK_LOG_LEVEL 0
+#endif
+#ifndef CONFIG_KERNEL_INIT_PRIORITY_DEVICE
+#define CONFIG_KERNEL_INIT_PRIORITY_DEVICE 50
+#endif
+#ifndef CONFIG_ZMK_RUNTIME_CONFIG
+#define CONFIG_ZMK_RUNTIME_CONFIG 1
+#endif
+
+#ifndef CONFIG_ZMK_POINTER_2S_MIXER
+#define CONFIG_ZMK_POINTER_2S_MIXER 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_FIXED_POINT
+#define CONFIG_POINTER_2S_MIXER_FIXED_POINT 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_LAZY_INIT
+#define CONFIG_POINTER_2S_MIXER_LAZY_INIT 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_FRAME_SYNC
+#define CONFIG_POINTER_2S_MIXER_FRAME_SYNC 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ENSURE_SYNC
+#define CONFIG_POINTER_2S_MIXER_ENSURE_SYNC 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SYNC_WINDOW_MS
+#define CONFIG_POINTER_2S_MIXER_SYNC_WINDOW_MS 24
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_REMAINDER_TTL
+#define CONFIG_POINTER_2S_MIXER_REMAINDER_TTL 16
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_REPORT_PACING
+#define CONFIG_POINTER_2S_MIXER_REPORT_PACING 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_REPORT_PACING_US
+#define CONFIG_POINTER_2S_MIXER_REPORT_PACING_US 1000
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ZRC_POLL_MS
+#define CONFIG_POINTER_2S_MIXER_ZRC_POLL_MS 500
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_EN
+#define CONFIG_POINTER_2S_MIXER_TWIST_EN 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_REMAINDER_TTL
+#define CONFIG_POINTER_2S_MIXER_TWIST_REMAINDER_TTL 32
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_FILTER_TTL
+#define CONFIG_POINTER_2S_MIXER_TWIST_FILTER_TTL 100
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_FILTER_DEBOUNCE
+#define CONFIG_POINTER_2S_MIXER_TWIST_FILTER_DEBOUNCE 24
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN
+#define CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_TTL
+#define CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_TTL 500
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_34_FILTER_EN
+#define CONFIG_POINTER_2S_MIXER_34_FILTER_EN 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_FEEDBACK_EN
+#define CONFIG_POINTER_2S_MIXER_FEEDBACK_EN 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SCROLL_DISABLES_POINTER
+#define CONFIG_POINTER_2S_MIXER_SCROLL_DISABLES_POINTER 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_POINTER_AFTER_SCROLL_ACTIVATION
+#define CONFIG_POINTER_2S_MIXER_POINTER_AFTER_SCROLL_ACTIVATION 100
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_MAX_VALUE
+#define CONFIG_POINTER_2S_MIXER_TWIST_MAX_VALUE 750
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_MUL
+#define CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_MUL 8
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_DIV
+#define CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_DIV 3
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_HYST_EN
+#define CONFIG_POINTER_2S_MIXER_TWIST_HYST_EN 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_HYST_THRES
+#define CONFIG_POINTER_2S_MIXER_TWIST_HYST_THRES 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_HYST_MUL
+#define CONFIG_POINTER_2S_MIXER_TWIST_HYST_MUL 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_HYST_DIV
+#define CONFIG_POINTER_2S_MIXER_TWIST_HYST_DIV 1
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_THRES
+#define CONFIG_POINTER_2S_MIXER_TWIST_THRES 4
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_THRESHOLD
+#define CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_THRESHOLD 100
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_DURATION
+#define CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_DURATION 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_FEEDBACK_MAX_CONTINUOUS
+#define CONFIG_POINTER_2S_MIXER_FEEDBACK_MAX_CONTINUOUS 150
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_FEEDBACK_COOLDOWN
+#define CONFIG_POINTER_2S_MIXER_FEEDBACK_COOLDOWN 25
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_EMA_ALPHA
+#define CONFIG_POINTER_2S_MIXER_EMA_ALPHA 25
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_STEADY_THRES
+#define CONFIG_POINTER_2S_MIXER_STEADY_THRES 5
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_STEADY_COOLDOWN
+#define CONFIG_POINTER_2S_MIXER_STEADY_COOLDOWN 100
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_DEFAULT_MOVE_COEF
+#define CONFIG_POINTER_2S_MIXER_DEFAULT_MOVE_COEF 25
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_DEFAULT_TWIST_COEF
+#define CONFIG_POINTER_2S_MIXER_DEFAULT_TWIST_COEF 25
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX
+#define CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX 12
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE
+#define CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE 3
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SMA_TIMEOUT
+#define CONFIG_POINTER_2S_MIXER_SMA_TIMEOUT 64
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ONE_EURO_MIN_CUTOFF
+#define CONFIG_POINTER_2S_MIXER_ONE_EURO_MIN_CUTOFF 100
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ONE_EURO_BETA
+#define CONFIG_POINTER_2S_MIXER_ONE_EURO_BETA 500
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ONE_EURO_D_CUTOFF
+#define CONFIG_POINTER_2S_MIXER_ONE_EURO_D_CUTOFF 200
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ONE_EURO_MAX_CUTOFF
+#define CONFIG_POINTER_2S_MIXER_ONE_EURO_MAX_CUTOFF 10000
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_PREDICT_EN
+#define CONFIG_POINTER_2S_MIXER_PREDICT_EN 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_PREDICT_HORIZON_US
+#define CONFIG_POINTER_2S_MIXER_PREDICT_HORIZON_US 2000
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_PREDICT_ALPHA
+#define CONFIG_POINTER_2S_MIXER_PREDICT_ALPHA 50
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_PREDICT_MAX
+#define CONFIG_POINTER_2S_MIXER_PREDICT_MAX 8
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ACCEL_TOP
+#define CONFIG_POINTER_2S_MIXER_ACCEL_TOP 400
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_GAIN
+#define CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_GAIN 200
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_MID
+#define CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_MID 100
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_WIDTH
+#define CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_WIDTH 30
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK
+#define CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_HEALTH
+#define CONFIG_POINTER_2S_MIXER_HEALTH 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_HEALTH_WINDOW_MS
+#define CONFIG_POINTER_2S_MIXER_HEALTH_WINDOW_MS 250
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_HEALTH_SATURATION
+#define CONFIG_POINTER_2S_MIXER_HEALTH_SATURATION 32767
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_HEALTH_NOISE_MAX
+#define CONFIG_POINTER_2S_MIXER_HEALTH_NOISE_MAX 2
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_HEALTH_NOISE_FRAMES
+#define CONFIG_POINTER_2S_MIXER_HEALTH_NOISE_FRAMES 20
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_RIGID_BODY
+#define CONFIG_POINTER_2S_MIXER_RIGID_BODY 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_RIGID_BODY_DEFAULT
+#define CONFIG_POINTER_2S_MIXER_RIGID_BODY_DEFAULT 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_RIGID_BODY_LEAK
+#define CONFIG_POINTER_2S_MIXER_RIGID_BODY_LEAK 20
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SCROLL_HI_RES
+#define CONFIG_POINTER_2S_MIXER_SCROLL_HI_RES 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SCROLL_BOTH
+#define CONFIG_POINTER_2S_MIXER_SCROLL_BOTH 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_QUANTILE
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_QUANTILE 95
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_MARGIN
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_MARGIN 150
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_MIN
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_MIN 75
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_MAX
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_MAX 400
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_PERIOD_MS
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_PERIOD_MS 1000
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_WARMUP
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_WARMUP 256
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_ADAPTIVE_SAVE_MIN
+#define CONFIG_POINTER_2S_MIXER_ADAPTIVE_SAVE_MIN 10
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL
+#define CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_KINETIC_TICK_MS
+#define CONFIG_POINTER_2S_MIXER_KINETIC_TICK_MS 10
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_KINETIC_RELEASE_MS
+#define CONFIG_POINTER_2S_MIXER_KINETIC_RELEASE_MS 30
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_KINETIC_FRICTION
+#define CONFIG_POINTER_2S_MIXER_KINETIC_FRICTION 30
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_KINETIC_START_SPEED
+#define CONFIG_POINTER_2S_MIXER_KINETIC_START_SPEED 20
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_KINETIC_STOP_SPEED
+#define CONFIG_POINTER_2S_MIXER_KINETIC_STOP_SPEED 3
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_QUEUE
+#define CONFIG_POINTER_2S_MIXER_QUEUE 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_QUEUE_SIZE
+#define CONFIG_POINTER_2S_MIXER_QUEUE_SIZE 64
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_QUEUE_PRIORITY
+#define CONFIG_POINTER_2S_MIXER_QUEUE_PRIORITY 5
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_QUEUE_STACK_SIZE
+#define CONFIG_POINTER_2S_MIXER_QUEUE_STACK_SIZE 1536
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_CALIBRATION
+#define CONFIG_POINTER_2S_MIXER_CALIBRATION 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_CALIBRATION_MIN_SAMPLES
+#define CONFIG_POINTER_2S_MIXER_CALIBRATION_MIN_SAMPLES 50
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_FEEDBACK_MAX_ARR_VALUES
+#define CONFIG_POINTER_2S_MIXER_FEEDBACK_MAX_ARR_VALUES 8
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_SETTINGS_SAVE_DELAY
+#define CONFIG_POINTER_2S_MIXER_SETTINGS_SAVE_DELAY 2500
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_STATS
+#define CONFIG_POINTER_2S_MIXER_STATS 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_CAPTURE
+#define CONFIG_POINTER_2S_MIXER_CAPTURE 0
+#endif
+#ifndef CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE
+#define CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE 1024
+#endif
+
+// devicetree (values of dts/input/processors/p2sm.dtsi + binding defaults)
+#ifndef P2SM_HOST_DT_sync_report_ms
+#define P2SM_HOST_DT_sync_report_ms 1
+#endif
+#ifndef P2SM_HOST_DT_sync_scroll_report_ms
+#define P2SM_HOST_DT_sync_scroll_report_ms 8
+#endif
+// optional, fall back to the ms values
+#ifndef P2SM_HOST_DT_sync_report_us
+#define P2SM_HOST_DT_sync_report_us ((P2SM_HOST_DT_sync_report_ms + 1) * 1000)
+#endif
+#ifndef P2SM_HOST_DT_sync_scroll_report_us
+#define P2SM_HOST_DT_sync_scroll_report_us ((P2SM_HOST_DT_sync_scroll_report_ms + 1) * 1000)
+#endif
+#ifndef P2SM_HOST_DT_twist_interference_thres
+#define P2SM_HOST_DT_twist_interference_thres 200
+#endif
+#ifndef P2SM_HOST_DT_twist_interference_window
+#define P2SM_HOST_DT_twist_interference_window 100
+#endif
+#ifndef P2SM_HOST_DT_sensor1_pos
+#define P2SM_HOST_DT_sensor1_pos { 0x31, 0x4b, 0x2d }
+#endif
+#ifndef P2SM_HOST_DT_sensor2_pos
+#define P2SM_HOST_DT_sensor2_pos { 0xc1, 0x3c, 0x2d }
+#endif
+#ifndef P2SM_HOST_DT_ball_radius
+#define P2SM_HOST_DT_ball_radius 102
+#endif
+#ifndef P2SM_HOST_DT_sensor1_scale
+#define P2SM_HOST_DT_sensor1_scale 100
+#endif
+#ifndef P2SM_HOST_DT_sensor2_scale
+#define P2SM_HOST_DT_sensor2_scale 100
+#endif
+#ifndef P2SM_HOST_DT_sensor1_flip
+#define P2SM_HOST_DT_sensor1_flip 0
+#endif
+#ifndef P2SM_HOST_DT_sensor2_flip
+#define P2SM_HOST_DT_sensor2_flip 0
+#endif
+#ifndef P2SM_HOST_DT_sensor1_trim
+#define P2SM_HOST_DT_sensor1_trim 0
+#endif
+#ifndef P2SM_HOST_DT_sensor2_trim
+#define P2SM_HOST_DT_sensor2_trim 0
+#endif
+#ifndef P2SM_HOST_DT_twist_feedback_delay
+#define P2SM_HOST_DT_twist_feedback_delay 5
+#endif
+#ifndef P2SM_HOST_DT_accel_curve
+#define P2SM_HOST_DT_accel_curve 0
+#endif
+// e.g. -D'P2SM_HOST_DT_accel_points={0,100,100,200}' -DP2SM_HOST_DT_accel_points_len=4
+#ifndef P2SM_HOST_DT_accel_points
+#define P2SM_HOST_DT_accel_points { 0 }
+#endif
+#ifndef P2SM_HOST_DT_accel_points_len
+#define P2SM_HOST_DT_accel_points_len 0
+#endif
@@ -0,0 +1,175 @@
+// Host implementations of the kernel, input and runtime-config calls the mixer makes.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <drivers/input_processor.h>
+#include <zmk_runtime_config/runtime_config.h>
+
+#include "host_stubs.h"
+
+static int64_t g_now_us = 0;
+
+int64_t host_now_us(void) { return g_now_us; }
+void host_set_now_us(const int64_t us) { g_now_us = us; }
+
+#define HOST_MAX_WORK 32
+static struct k_work_delayable *g_work[HOST_MAX_WORK];
+static struct k_work *g_submitted[HOST_MAX_WORK];
+static size_t g_submitted_cnt = 0;
+
+int host_work_schedule(struct k_work_delayable *dwork, const k_timeout_t delay) {
+    dwork->pending = true;
+    dwork->due_us = g_now_us + delay.ticks;
+    for (size_t i = 0; i < HOST_MAX_WORK; i++) {
+        if (g_work[i] == dwork) {
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < HOST_MAX_WORK; i++) {
+        if (g_work[i] == NULL) {
+            g_work[i] = dwork;
+            return 1;
+        }
+    }
+    fprintf(stderr, "host: delayable work registry full\n");
+    abort();
+}
+
+int host_work_cancel(struct k_work_delayable *dwork) {
+    dwork->pending = false;
+    return 0;
+}
+
+int host_work_submit(struct k_work *work) {
+    // like Zephyr, an item that is already queued stays queued once
+    for (size_t i = 0; i < g_submitted_cnt; i++) {
+        if (g_submitted[i] == work) {
+            return 0;
+        }
+    }
+    if (g_submitted_cnt >= HOST_MAX_WORK) {
+        fprintf(stderr, "host: work queue full\n");
+        abort();
+    }
+    g_submitted[g_submitted_cnt++] = work;
+    return 1;
+}
+
+void host_run_work(void) {
+    while (g_submitted_cnt > 0) {
+        struct k_work *work = g_submitted[0];
+        memmove(g_submitted, g_submitted + 1, --g_submitted_cnt * sizeof(g_submitted[0]));
+        work->handler(work);
+    }
+    for (size_t i = 0; i < HOST_MAX_WORK; i++) {
+        struct k_work_delayable *dwork = g_work[i];
+        if (dwork != NULL && dwork->pending && dwork->due_us <= g_now_us) {
+            dwork->pending = false;
+            dwork->work.handler(&dwork->work);
+        }
+    }
+}
+
+void host_run_until(const int64_t t_us) {
+    for (;;) {
+        host_run_work();
+        struct k_work_delayable *next = NULL;
+        for (size_t i = 0; i < HOST_MAX_WORK; i++) {
+            struct k_work_delayable *dwork = g_work[i];
+            if (dwork != NULL && dwork->pending && dwork->due_us <= t_us &&
+                (next == NULL || dwork->due_us < next->due_us)) {
+                next = dwork;
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+        g_now_us = MAX(g_now_us, next->due_us);
+    }
+    g_now_us = t_us;
+}
+
+static struct host_report_sink *g_sink = NULL;
+
+static const char *host_code_name(const uint16_t code) {
+    switch (code) {
+    case INPUT_REL_X: return "REL_X";
+    case INPUT_REL_Y: return "REL_Y";
+    case INPUT_REL_WHEEL: return "REL_WHEEL";
+    case INPUT_REL_HWHEEL: return "REL_HWHEEL";
+    case INPUT_REL_WHEEL_HI_RES: return "REL_WHEEL_HI_RES";
+    case INPUT_REL_HWHEEL_HI_RES: return "REL_HWHEEL_HI_RES";
+    default: return "REL_?";
+    }
+}
+
+void host_set_report_sink(struct host_report_sink *sink) { g_sink = sink; }
+
+int input_report(const struct device *dev, const uint8_t type, const uint16_t code, const int32_t value,
+                 const bool sync, const k_timeout_t timeout) {
+    (void) dev;
+    (void) timeout;
+    if (g_sink != NULL) {
+        g_sink->reports++;
+        if (code == INPUT_REL_X) {
+            g_sink->sum_x += value;
+        } else if (code == INPUT_REL_Y) {
+            g_sink->sum_y += value;
+        } else if (code == INPUT_REL_WHEEL) {
+            g_sink->sum_wheel += value;
+        } else if (code == INPUT_REL_WHEEL_HI_RES) {
+            g_sink->sum_wheel_hi_res += value;
+        }
+        if (g_sink->trace != NULL) {
+            fprintf(g_sink->trace, "%lld.%03lld %s %d%s\n", (long long) (g_now_us / 1000),
+                    (long long) (g_now_us % 1000), host_code_name(code), value, sync ? "" : " +");
+        }
+    }
+    return 0;
+}
+
+void p2sm_sens_driver_init(void) {}
+
+#define HOST_MAX_ZRC 64
+static struct {
+    const char *key;
+    int32_t value, min_val, max_val;
+} g_zrc[HOST_MAX_ZRC];
+static size_t g_zrc_cnt = 0;
+uint32_t host_zrc_reads = 0;
+
+int zrc_register(const char *key, const int32_t default_val, const int32_t min_val, const int32_t max_val) {
+    if (g_zrc_cnt >= HOST_MAX_ZRC) {
+        return -ENOMEM;
+    }
+    g_zrc[g_zrc_cnt].key = key;
+    g_zrc[g_zrc_cnt].value = default_val;
+    g_zrc[g_zrc_cnt].min_val = min_val;
+    g_zrc[g_zrc_cnt].max_val = max_val;
+    g_zrc_cnt++;
+    return 0;
+}
+
+int32_t zrc_get(const char *key) {
+    host_zrc_reads++;
+    for (size_t i = 0; i < g_zrc_cnt; i++) {
+        if (strcmp(g_zrc[i].key, key) == 0) {
+            return g_zrc[i].value;
+        }
+    }
+    return 0;
+}
+
+int zrc_set(const char *key, const int32_t value) {
+    for (size_t i = 0; i < g_zrc_cnt; i++) {
+        if (strcmp(g_zrc[i].key, key) == 0) {
+            if (value < g_zrc[i].min_val || value > g_zrc[i].max_val) {
+                return -EINVAL;
+            }
+            g_zrc[i].value = value;
+            return 0;
+        }
+    }
+    return -ENOENT;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <zephyr/device.h>
+
+// devices have been up for a while when input starts
+#define HOST_CLOCK_BASE_US 1000000
+
+struct host_report_sink {
+    uint64_t reports;
+    int64_t sum_x, sum_y, sum_wheel, sum_wheel_hi_res;
+    FILE *trace; // optional, one "<ms.us> <code> <value>" line per input_report(), " +" if not synced
+};
+
+void host_set_report_sink(struct host_report_sink *sink);
+extern uint32_t host_zrc_reads;
+
+// provided by DEVICE_DT_INST_DEFINE in the mixer translation unit
+extern struct device host_mixer_dev;
+int host_mixer_init(void);
@@ -0,0 +1,32 @@
+#pragma once
+#include <zephyr/device.h>
+
+#define INPUT_EV_REL 0x02
+#define INPUT_REL_X 0x00
+#define INPUT_REL_Y 0x01
+#define INPUT_REL_HWHEEL 0x06
+#define INPUT_REL_WHEEL 0x08
+#define INPUT_REL_WHEEL_HI_RES 0x0b
+#define INPUT_REL_HWHEEL_HI_RES 0x0c
+
+struct input_event {
+    const struct device *dev;
+    uint8_t sync;
+    uint8_t type;
+    uint16_t code;
+    int32_t value;
+};
+
+struct zmk_input_processor_state {
+    uint8_t input_device_index;
+    int16_t *remainder;
+};
+
+struct zmk_input_processor_driver_api {
+    int (*handle_event)(const struct device *dev, struct input_event *event, uint32_t param1,
+                        uint32_t param2, struct zmk_input_processor_state *state);
+};
+
+// recorded by the harness
+int input_report(const struct device *dev, uint8_t type, uint16_t code, int32_t value, bool sync,
+                 k_timeout_t timeout);
@@ -0,0 +1,27 @@
+#pragma once
+#include <zephyr/kernel.h>
+
+struct device {
+    const char *name;
+    const void *config;
+    const void *api;
+    void *data;
+};
+
+// devicetree values come from host_config.h as P2SM_HOST_DT_<prop>
+#define DT_INST_PROP(inst, prop) P2SM_HOST_DT_##prop
+#define DT_INST_PROP_OR(inst, prop, default_value) P2SM_HOST_DT_##prop
+#define DT_INST_PROP_LEN_OR(inst, prop, default_value) P2SM_HOST_DT_##prop##_len
+#define DT_HAS_COMPAT_STATUS_OKAY(compat) 1
+#define DEVICE_DT_NAME(inst) "host"
+
+// the harness builds a single mixer instance
+#define DT_NUM_INST_STATUS_OKAY(compat) 1
+#define DT_INST_FOREACH_STATUS_OKAY(fn) fn(0)
+
+// exposed to the harness as host_mixer_dev
+#define DEVICE_DT_INST_DEFINE(inst, init_fn, pm, data_ptr, cfg_ptr, level, prio, api_ptr) \
+    struct device host_mixer_dev = {                                                      \
+        .name = "zip_2s_mixer", .config = (cfg_ptr), .api = (api_ptr), .data = (data_ptr)   \
+    };                                                                                     \
+    int host_mixer_init(void) { return (init_fn)(&host_mixer_dev); }
@@ -0,0 +1,2 @@
+#pragma once
+#include <zephyr/sys/util.h>
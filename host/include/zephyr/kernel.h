@@ -0,0 +1,138 @@
+#pragma once
+// Minimal host stand-in for the parts of the Zephyr kernel API used by the mixer.
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <zephyr/sys/util.h>
+
+typedef struct { int64_t ticks; } k_timeout_t;
+#define K_NO_WAIT ((k_timeout_t) { 0 })
+#define K_MSEC(ms) ((k_timeout_t) { (int64_t) (ms) * 1000 })
+#define K_MINUTES(m) K_MSEC((int64_t) (m) * 60 * 1000)
+#define K_USEC(us) ((k_timeout_t) { (int64_t) (us) })
+#define USEC_PER_MSEC 1000U
+#define USEC_PER_SEC 1000000U
+#define K_FOREVER ((k_timeout_t) { -1 })
+
+// virtual clock, advanced by the host harness
+int64_t host_now_us(void);
+void host_set_now_us(int64_t us);
+
+static inline int64_t k_uptime_get(void) { return host_now_us() / 1000; }
+static inline uint32_t k_uptime_get_32(void) { return (uint32_t) k_uptime_get(); }
+static inline uint32_t k_cycle_get_32(void) { return (uint32_t) host_now_us(); }
+static inline uint64_t k_cycle_get_64(void) { return (uint64_t) host_now_us(); }
+static inline uint32_t sys_clock_hw_cycles_per_sec(void) { return 1000000; }
+static inline uint32_t k_cyc_to_us_floor32(const uint32_t cyc) { return cyc; }
+static inline uint64_t k_cyc_to_ns_floor64(const uint64_t cyc) { return cyc * 1000; }
+static inline int64_t k_uptime_ticks(void) { return host_now_us(); }
+static inline uint64_t k_ticks_to_us_floor64(const uint64_t t) { return t; }
+static inline uint32_t k_us_to_cyc_ceil32(const uint32_t us) { return us; }
+static inline int32_t k_usleep(int32_t us) { (void) us; return 0; }
+
+typedef long atomic_t;
+typedef atomic_t atomic_val_t;
+typedef void *atomic_ptr_t;
+#define ATOMIC_INIT(i) (i)
+#define ATOMIC_PTR_INIT(p) (p)
+static inline atomic_val_t atomic_get(const atomic_t *target) { return __atomic_load_n(target, __ATOMIC_SEQ_CST); }
+static inline atomic_val_t atomic_set(atomic_t *target, atomic_val_t value) { return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST); }
+static inline atomic_val_t atomic_inc(atomic_t *target) { return __atomic_fetch_add(target, 1, __ATOMIC_SEQ_CST); }
+static inline atomic_val_t atomic_add(atomic_t *target, atomic_val_t value) { return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST); }
+static inline void *atomic_ptr_get(const atomic_ptr_t *target) { return __atomic_load_n(target, __ATOMIC_SEQ_CST); }
+static inline void *atomic_ptr_set(atomic_ptr_t *target, void *value) { return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST); }
+
+static inline bool atomic_test_and_set_bit(atomic_t *target, int bit) {
+    return (__atomic_fetch_or(target, 1L << bit, __ATOMIC_SEQ_CST) & (1L << bit)) != 0;
+}
+static inline void atomic_clear_bit(atomic_t *target, int bit) { __atomic_fetch_and(target, ~(1L << bit), __ATOMIC_SEQ_CST); }
+
+// the host tools run on one thread
+typedef const void *k_tid_t;
+static inline k_tid_t k_current_get(void) { return (k_tid_t) 1; }
+#define __ASSERT(test, fmt, ...) assert(test)
+
+// the host tools are single-threaded, a mutex only has to catch misuse
+struct k_mutex {
+    uint32_t lock_count;
+};
+#define K_MUTEX_DEFINE(name) struct k_mutex name = { 0 }
+static inline int k_mutex_init(struct k_mutex *mutex) { mutex->lock_count = 0; return 0; }
+static inline int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout) { (void) timeout; mutex->lock_count++; return 0; }
+static inline int k_mutex_unlock(struct k_mutex *mutex) { return mutex->lock_count-- > 0 ? 0 : -EINVAL; }
+
+struct k_spinlock {
+    uint32_t locked;
+};
+typedef uint32_t k_spinlock_key_t;
+static inline k_spinlock_key_t k_spin_lock(struct k_spinlock *l) { return l->locked++; }
+static inline void k_spin_unlock(struct k_spinlock *l, k_spinlock_key_t key) { l->locked = key; }
+
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+struct k_work {
+    k_work_handler_t handler;
+};
+struct k_work_delayable {
+    struct k_work work;
+    bool pending;
+    int64_t due_us;
+};
+
+#define K_WORK_DEFINE(work, work_handler) struct k_work work = { .handler = (work_handler) }
+
+static inline void k_work_init(struct k_work *work, k_work_handler_t handler) { work->handler = handler; }
+static inline void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler) {
+    dwork->work.handler = handler;
+    dwork->pending = false;
+}
+static inline struct k_work_delayable *k_work_delayable_from_work(struct k_work *work) {
+    return CONTAINER_OF(work, struct k_work_delayable, work);
+}
+
+// delayed work is tracked in a small registry and fired by host_run_work()
+int host_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int host_work_cancel(struct k_work_delayable *dwork);
+int host_work_submit(struct k_work *work);
+void host_run_work(void);
+// advances the clock to t_us, firing delayed work at its due time on the way
+void host_run_until(int64_t t_us);
+
+static inline int k_work_reschedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+    return host_work_schedule(dwork, delay);
+}
+static inline int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay) {
+    return dwork->pending ? 0 : host_work_schedule(dwork, delay);
+}
+static inline int k_work_cancel_delayable(struct k_work_delayable *dwork) { return host_work_cancel(dwork); }
+static inline bool k_work_delayable_is_pending(const struct k_work_delayable *dwork) { return dwork->pending; }
+static inline int k_work_submit(struct k_work *work) { return host_work_submit(work); }
+
+// work queues run in the same single host thread as everything else
+struct k_work_q {
+    const char *name;
+};
+struct k_work_queue_config {
+    const char *name;
+    bool no_yield;
+};
+#define K_THREAD_STACK_DEFINE(sym, size) char sym[size]
+#define K_THREAD_STACK_SIZEOF(sym) sizeof(sym)
+static inline void k_work_queue_init(struct k_work_q *queue) { queue->name = NULL; }
+static inline void k_work_queue_start(struct k_work_q *queue, char *stack, size_t stack_size, int prio,
+                                      const struct k_work_queue_config *cfg) {
+    (void) stack;
+    (void) stack_size;
+    (void) prio;
+    queue->name = cfg != NULL ? cfg->name : NULL;
+}
+static inline int k_work_submit_to_queue(struct k_work_q *queue, struct k_work *work) {
+    (void) queue;
+    return host_work_submit(work);
+}
+
+#define SYS_INIT(fn, level, prio) \
+    __attribute__((constructor)) static void _host_sys_init_##fn(void) { (void) fn(); }
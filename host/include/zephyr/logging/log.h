@@ -0,0 +1,14 @@
+#pragma once
+#include <stdio.h>
+
+#define LOG_MODULE_DECLARE(...)
+#define LOG_MODULE_REGISTER(...)
+
+#if defined(P2SM_HOST_LOG)
+#define LOG_DBG(fmt, ...) fprintf(stderr, "<dbg> " fmt "\n", ##__VA_ARGS__)
+#else
+#define LOG_DBG(fmt, ...) do { if (0) fprintf(stderr, fmt, ##__VA_ARGS__); } while (0)
+#endif
+#define LOG_INF(fmt, ...) LOG_DBG(fmt, ##__VA_ARGS__)
+#define LOG_WRN(fmt, ...) fprintf(stderr, "<wrn> " fmt "\n", ##__VA_ARGS__)
+#define LOG_ERR(fmt, ...) fprintf(stderr, "<err> " fmt "\n", ##__VA_ARGS__)
@@ -0,0 +1,32 @@
+#pragma once
+#include <stddef.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define CONTAINER_OF(ptr, type, field) ((type *) (((char *) (ptr)) - offsetof(type, field)))
+#define ARG_UNUSED(x) (void) (x)
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+#define CLAMP(val, lo, hi) (((val) <= (lo)) ? (lo) : MIN(val, hi))
+#define DIV_ROUND_UP(n, d) (((n) + (d) - 1) / (d))
+#ifndef BIT
+#define BIT(n) (1UL << (n))
+#endif
+#define STRINGIFY(s) Z_STRINGIFY(s)
+#define Z_STRINGIFY(s) #s
+#define BUILD_ASSERT(cond, msg) _Static_assert(cond, msg)
+#define __noinline __attribute__((noinline))
+#define __aligned(x) __attribute__((aligned(x)))
+#define __unused __attribute__((unused))
+
+// same trick as Zephyr: works for both undefined and 0/1 defined symbols
+#define Z_IS_ENABLED_XXXX1 Z_IS_ENABLED_YYYY,
+#define IS_ENABLED(config_macro) Z_IS_ENABLED1(config_macro)
+#define Z_IS_ENABLED1(config_macro) Z_IS_ENABLED2(Z_IS_ENABLED_XXXX##config_macro)
+#define Z_IS_ENABLED2(one_or_two_args) Z_IS_ENABLED3(one_or_two_args 1, 0)
+#define Z_IS_ENABLED3(ignore_this, val, ...) val
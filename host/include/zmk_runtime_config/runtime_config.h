@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+
+// in-memory key/value table standing in for zmk-runtime-config
+int zrc_register(const char *key, int32_t default_val, int32_t min_val, int32_t max_val);
+int32_t zrc_get(const char *key);
+int zrc_set(const char *key, int32_t value);
+
+#define ZRC_GET(key, default_val) zrc_get(key)
@@ -0,0 +1,484 @@
+// Host benchmark for the mixer hot path.
+// Builds pointer_2s_mixer.c against the stubs in include/ and drives it with
+// synthetic two-sensor streams on a virtual clock; timings are wall-clock.
+#include <getopt.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../src/pointing/pointer_2s_mixer.c"
+#include "host_stubs.h"
+#include "p2sm_gen.h"
+
+#define BENCH_STAGE_ITERS 200000
+
+static uint64_t ns_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    const uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return x < y ? -1 : x > y;
+}
+
+struct bench_stats {
+    uint64_t total_ns;
+    uint32_t p50, p99, max;
+};
+
+static struct bench_stats summarize(uint32_t *samples, const size_t n) {
+    struct bench_stats st = {0};
+    for (size_t i = 0; i < n; i++) {
+        st.total_ns += samples[i];
+    }
+    qsort(samples, n, sizeof(*samples), cmp_u32);
+    st.p50 = samples[n / 2];
+    st.p99 = samples[(n * 99) / 100];
+    st.max = samples[n - 1];
+    return st;
+}
+
+static void print_stats(const char *name, const struct bench_stats *st, const size_t n) {
+    printf("  %-12s %8.1f ns/op   p50 %6u   p99 %6u   max %8u\n", name, (double) st->total_ns / (double) n,
+           st->p50, st->p99, st->max);
+}
+
+// per-sample numbers include the cost of reading the clock twice
+static void print_timer_overhead(void) {
+    uint32_t samples[1024];
+    for (size_t i = 0; i < ARRAY_SIZE(samples); i++) {
+        const uint64_t t0 = ns_now();
+        samples[i] = (uint32_t) (ns_now() - t0);
+    }
+    const struct bench_stats st = summarize(samples, ARRAY_SIZE(samples));
+    printf("timer overhead: p50 %u ns\n", st.p50);
+}
+
+static void reset_mixer(void) {
+    struct zip_pointer_2s_mixer_data *d = host_mixer_dev.data;
+    memset(&d->frame, 0, sizeof(d->frame));
+    memset(&d->twist_values, 0, sizeof(d->twist_values));
+    memset(d->rotated_x, 0, sizeof(d->rotated_x));
+    memset(d->rotated_y, 0, sizeof(d->rotated_y));
+    d->rpt_x_remainder = 0;
+    d->rpt_y_remainder = 0;
+    d->rpt_twist_remainder = 0;
+#if P2SM_SCROLL_HI_RES
+    d->rpt_twist_hr_remainder = 0;
+#endif
+}
+
+static void mixer_gen_init(struct p2sm_gen *gen, const enum p2sm_gen_scenario scenario, const uint32_t rate_hz) {
+    const struct zip_pointer_2s_mixer_config *config = host_mixer_dev.config;
+    const struct zip_pointer_2s_mixer_data *d = host_mixer_dev.data;
+    float m1[2][2], m2[2][2];
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            m1[i][j] = P2SM_COEF_TO_FLOAT(d->proj[0][i][j]);
+            m2[i][j] = P2SM_COEF_TO_FLOAT(d->proj[1][i][j]);
+        }
+    }
+    float p1[3], p2[3];
+    sensor_surface_pos(config->ball_radius, config->sensor1_pos, p1);
+    sensor_surface_pos(config->ball_radius, config->sensor2_pos, p2);
+    const float pos[2][2] = { { p1[0], p1[1] }, { p2[0], p2[1] } };
+    p2sm_gen_init(gen, scenario, rate_hz, m1, m2, pos);
+}
+
+// same layout as "p2sm capture dump", one record per line
+static void write_capture_rec(FILE *f, const struct p2sm_gen_event *ev) {
+    const uint32_t t = (uint32_t) ev->t_us;
+    const uint16_t v = (uint16_t) ev->value;
+    fprintf(f, "cap %02x%02x%02x%02x%02x%02x%02x%02x\n", t & 0xFF, (t >> 8) & 0xFF, (t >> 16) & 0xFF, t >> 24,
+            v & 0xFF, v >> 8, ev->code, (unsigned) (ev->sensor | (ev->sync ? BIT(7) : 0)));
+}
+
+struct lag_sample {
+    double t_ms;
+    double true_pos[2], rpt_pos[2];
+};
+
+// how far the reported position trails the generated one, in ms along the
+// direction of motion: the position error divided by the speed, after fitting
+// the overall gain (sensitivity, two sensors) by least squares; negative when
+// prediction runs ahead
+static void print_lag(const struct lag_sample *s, const size_t n) {
+    double rt = 0, tt = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (int a = 0; a < 2; a++) {
+            rt += s[i].rpt_pos[a] * s[i].true_pos[a];
+            tt += s[i].true_pos[a] * s[i].true_pos[a];
+        }
+    }
+    if (tt < 1.0 || rt <= 0) {
+        return;
+    }
+
+    const double k = rt / tt;
+    double lag_sum = 0;
+    size_t lag_cnt = 0;
+    for (size_t i = 1; i < n; i++) {
+        const double dt = s[i].t_ms - s[i - 1].t_ms;
+        const double vx = k * (s[i].true_pos[0] - s[i - 1].true_pos[0]) / dt;
+        const double vy = k * (s[i].true_pos[1] - s[i - 1].true_pos[1]) / dt;
+        const double speed = sqrt(vx * vx + vy * vy);
+        if (dt <= 0 || speed < 0.5) {
+            continue;
+        }
+        const double ex = s[i].rpt_pos[0] - k * s[i].true_pos[0];
+        const double ey = s[i].rpt_pos[1] - k * s[i].true_pos[1];
+        lag_sum += -(ex * vx + ey * vy) / (speed * speed);
+        lag_cnt++;
+    }
+    if (lag_cnt > 0) {
+        printf("  %-12s %8.2f ms behind (gain %.3f)\n", "lag", lag_sum / (double) lag_cnt, k);
+    }
+}
+
+// wraparound shows up as a frame whose reports run against the motion by more
+// than the motion itself; lag alone only ever trails behind by less
+static void print_wrong_way(const struct lag_sample *s, const size_t n) {
+    double rt = 0, tt = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (int a = 0; a < 2; a++) {
+            rt += s[i].rpt_pos[a] * s[i].true_pos[a];
+            tt += s[i].true_pos[a] * s[i].true_pos[a];
+        }
+    }
+    const double k = tt < 1.0 ? 0 : rt / tt;
+    size_t wrong = 0;
+    for (size_t i = 1; i < n; i++) {
+        const double tx = k * (s[i].true_pos[0] - s[i - 1].true_pos[0]);
+        const double ty = k * (s[i].true_pos[1] - s[i - 1].true_pos[1]);
+        const double rx = s[i].rpt_pos[0] - s[i - 1].rpt_pos[0];
+        const double ry = s[i].rpt_pos[1] - s[i - 1].rpt_pos[1];
+        const double along = rx * tx + ry * ty;
+        if (along < 0 && along * along > 4.0 * (tx * tx + ty * ty) * (tx * tx + ty * ty)) {
+            wrong++;
+        }
+    }
+    if (wrong > 0) {
+        printf("  %-12s %8zu frames against the motion\n", "wrong-way", wrong);
+    }
+}
+
+// end-to-end: every event through the processor API, as the input thread would,
+// or with batch > 1 that many frames at a time through p2sm_mix_batch()
+static void bench_stream(const enum p2sm_gen_scenario scenario, const uint32_t rate_hz, const size_t frames,
+                         const size_t batch, FILE *trace, FILE *capture) {
+    const struct zmk_input_processor_driver_api *api = host_mixer_dev.api;
+    struct host_report_sink sink = { .trace = trace };
+    struct p2sm_gen gen;
+    struct p2sm_gen_event ev[P2SM_GEN_MAX_EVENTS];
+
+    const size_t max_events = frames * P2SM_GEN_MAX_EVENTS;
+    uint32_t *samples = malloc(max_events * sizeof(*samples));
+    struct lag_sample *lag = malloc(frames * sizeof(*lag));
+    struct p2sm_event *pending = malloc(batch * P2SM_GEN_MAX_EVENTS * sizeof(*pending));
+    size_t n = 0, npending = 0;
+
+    reset_mixer();
+    host_set_report_sink(&sink);
+    mixer_gen_init(&gen, scenario, rate_hz);
+    if (capture != NULL) {
+        fprintf(capture, "cap-begin v1 %zu 0\n", frames * P2SM_GEN_MAX_EVENTS);
+    }
+
+    for (size_t f = 0; f < frames; f++) {
+        const size_t cnt = p2sm_gen_next(&gen, ev);
+        for (size_t i = 0; i < cnt; i++) {
+            host_run_until(HOST_CLOCK_BASE_US + ev[i].t_us);
+            struct input_event event = {
+                .type = INPUT_EV_REL, .code = ev[i].code, .value = ev[i].value, .sync = ev[i].sync,
+            };
+
+            if (capture != NULL) {
+                write_capture_rec(capture, &ev[i]);
+            }
+
+            if (batch > 1) {
+                pending[npending++] = (struct p2sm_event) {
+                    .t_us = p2sm_now_us(), .value = (int16_t) ev[i].value, .code = (uint8_t) ev[i].code,
+                    .flags = (uint8_t) (ev[i].sensor | (ev[i].sync ? P2SM_EVENT_SYNC : 0)),
+                };
+                continue;
+            }
+
+            const uint64_t t0 = ns_now();
+            api->handle_event(&host_mixer_dev, &event, ev[i].sensor, 0, NULL);
+            samples[n++] = (uint32_t) (ns_now() - t0);
+        }
+
+        // per event: the batch cost spread evenly over its events
+        if (batch > 1 && ((f + 1) % batch == 0 || f + 1 == frames)) {
+            const uint64_t t0 = ns_now();
+            p2sm_mix_batch(0, pending, npending);
+            const uint32_t per_event = (uint32_t) ((ns_now() - t0) / MAX(npending, 1));
+            for (size_t i = 0; i < npending; i++) {
+                samples[n++] = per_event;
+            }
+            npending = 0;
+        }
+        host_run_work();
+
+        lag[f] = (struct lag_sample) {
+            .t_ms = (double) (host_now_us() - HOST_CLOCK_BASE_US) / 1000.0,
+            .true_pos = { gen.pos[0], gen.pos[1] },
+            .rpt_pos = { (double) sink.sum_x, (double) sink.sum_y },
+        };
+    }
+
+    host_set_report_sink(NULL);
+    if (capture != NULL) {
+        fprintf(capture, "cap-end\n");
+    }
+    const struct bench_stats st = summarize(samples, n);
+    printf("%s @ %u Hz: %zu events, %llu reports (x %lld, y %lld, wheel %lld)\n", p2sm_gen_name(scenario), rate_hz,
+           n, (unsigned long long) sink.reports, (long long) sink.sum_x, (long long) sink.sum_y,
+           (long long) sink.sum_wheel);
+#if P2SM_SCROLL_HI_RES
+    printf("wheel hi-res %lld (%.2f notches)\n", (long long) sink.sum_wheel_hi_res,
+           (double) sink.sum_wheel_hi_res / P2SM_HI_RES_PER_NOTCH);
+#endif
+    print_stats(batch > 1 ? "mix_batch" : "handle_event", &st, n);
+    print_lag(lag, frames);
+    print_wrong_way(lag, frames);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+    const struct p2sm_stats *stats = &((struct zip_pointer_2s_mixer_data *) host_mixer_dev.data)->stats;
+    printf("  %-12s frame %u, projection %u, twist %u, report %u\n", "clipped",
+           stats->clipped[P2SM_CLIP_FRAME], stats->clipped[P2SM_CLIP_PROJECTION],
+           stats->clipped[P2SM_CLIP_TWIST], stats->clipped[P2SM_CLIP_REPORT]);
+    printf("  %-12s", "twist");
+    for (int i = 0; i < P2SM_TWIST_STATE_COUNT; i++) {
+        for (int j = 0; j < P2SM_TWIST_STATE_COUNT; j++) {
+            if (stats->twist_transitions[i][j] != 0) {
+                printf(" %d>%d %u", i, j, stats->twist_transitions[i][j]);
+            }
+        }
+    }
+    printf(" (see enum p2sm_twist_state)\n");
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+    printf("  %-12s %u coasts, %u caught\n", "kinetic", stats->coasts, stats->coast_catches);
+#endif
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+    struct p2sm_adaptive adapt = { 0 };
+    p2sm_adaptive_get(0, &adapt);
+    printf("  %-12s noise %.2f (%u), leak %.2f (%u), twist_thres %u, interference %u\n", "adaptive",
+           adapt.noise / 256.0, adapt.noise_samples, adapt.leak / 256.0, adapt.leak_samples, adapt.twist_thres,
+           adapt.interference);
+#endif
+    free(samples);
+    free(lag);
+    free(pending);
+}
+
+// per-stage: each stage in isolation on representative state
+static void bench_stages(void) {
+    struct zip_pointer_2s_mixer_data *d = host_mixer_dev.data;
+    uint32_t *samples = malloc(BENCH_STAGE_ITERS * sizeof(*samples));
+    struct bench_stats st;
+    struct input_event event = { .type = INPUT_EV_REL, .code = INPUT_REL_X, .value = 3 };
+    volatile p2sm_num_t sink_x = 0, sink_y = 0;
+
+    printf("stages:\n");
+    reset_mixer();
+    const struct p2sm_params *params = params_acquire(d);
+
+    for (size_t i = 0; i < BENCH_STAGE_ITERS; i++) {
+        const uint64_t t0 = ns_now();
+        on_sensor_event(d, i & 1, &event, false, (uint32_t) i, false);
+        samples[i] = (uint32_t) (ns_now() - t0);
+    }
+    st = summarize(samples, BENCH_STAGE_ITERS);
+    print_stats("accumulate", &st, BENCH_STAGE_ITERS);
+
+    for (size_t i = 0; i < BENCH_STAGE_ITERS; i++) {
+        d->rotated_x[0] = 0;
+        d->rotated_y[0] = 0;
+        const uint64_t t0 = ns_now();
+        project_frame(d, 0, (int32_t) (i & 31) - 16, 7);
+        samples[i] = (uint32_t) (ns_now() - t0);
+        sink_x = d->rotated_x[0];
+        sink_y = d->rotated_y[0];
+    }
+    st = summarize(samples, BENCH_STAGE_ITERS);
+    print_stats("rotate", &st, BENCH_STAGE_ITERS);
+
+    // smoothing modes on the same input, 2 ms apart
+    for (size_t i = 0; i < BENCH_STAGE_ITERS; i++) {
+        p2sm_num_t x = P2SM_FROM_INT((int32_t) (i & 7) - 3), y = P2SM_FROM_INT(2);
+        const uint64_t t0 = ns_now();
+        apply_sma(d, params->sma_window_size, (uint32_t) i * 2000, &x, &y);
+        samples[i] = (uint32_t) (ns_now() - t0);
+        sink_x = x;
+        sink_y = y;
+    }
+    st = summarize(samples, BENCH_STAGE_ITERS);
+    print_stats("sma", &st, BENCH_STAGE_ITERS);
+
+    for (size_t i = 0; i < BENCH_STAGE_ITERS; i++) {
+        p2sm_num_t x = P2SM_FROM_INT((int32_t) (i & 7) - 3), y = P2SM_FROM_INT(2);
+        const uint64_t t0 = ns_now();
+        apply_one_euro(d, params, 2000, &x, &y);
+        samples[i] = (uint32_t) (ns_now() - t0);
+        sink_x = x;
+        sink_y = y;
+    }
+    st = summarize(samples, BENCH_STAGE_ITERS);
+    print_stats("1euro", &st, BENCH_STAGE_ITERS);
+
+    // acceleration lookup across the whole table, 1 ms apart
+    for (size_t i = 0; i < BENCH_STAGE_ITERS; i++) {
+        const p2sm_num_t x = P2SM_FROM_INT((int32_t) (i & 63) - 32), y = P2SM_FROM_INT(3);
+        const uint64_t t0 = ns_now();
+        sink_x = accel_gain(params, x, y, 1000);
+        samples[i] = (uint32_t) (ns_now() - t0);
+    }
+    st = summarize(samples, BENCH_STAGE_ITERS);
+    print_stats("accel", &st, BENCH_STAGE_ITERS);
+
+    for (size_t i = 0; i < BENCH_STAGE_ITERS; i++) {
+        host_set_now_us((int64_t) i * 1000);
+        d->rotated_x[0] = P2SM_FROM_INT(5);
+        d->rotated_y[0] = P2SM_FROM_INT(-3);
+        d->rotated_x[1] = P2SM_FROM_INT(4);
+        d->rotated_y[1] = P2SM_FROM_INT(-2);
+        const uint32_t now = p2sm_now_us();
+        const uint64_t t0 = ns_now();
+        process_and_report(&host_mixer_dev, params, now);
+        samples[i] = (uint32_t) (ns_now() - t0);
+    }
+    st = summarize(samples, BENCH_STAGE_ITERS);
+    print_stats("report", &st, BENCH_STAGE_ITERS);
+
+    for (size_t i = 0; i < BENCH_STAGE_ITERS; i++) {
+        host_set_now_us((int64_t) i * 8000);
+        d->twist_values.s1_x = 1;
+        d->twist_values.s1_y = 24;
+        d->twist_values.s2_x = -1;
+        d->twist_values.s2_y = -22;
+        const uint32_t now = p2sm_now_us();
+        const uint64_t t0 = ns_now();
+        sink_x = calculate_twist(&host_mixer_dev, params, now);
+        samples[i] = (uint32_t) (ns_now() - t0);
+    }
+    st = summarize(samples, BENCH_STAGE_ITERS);
+    print_stats("twist", &st, BENCH_STAGE_ITERS);
+
+    (void) sink_x;
+    (void) sink_y;
+    free(samples);
+}
+
+// twist estimator, -1 if unknown or not built in (RIGID_BODY)
+static int parse_estimator(const char *name) {
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    if (strcmp(name, "heuristic") == 0) {
+        return P2SM_TWIST_HEURISTIC;
+    }
+    if (strcmp(name, "rigid") == 0) {
+        return P2SM_TWIST_RIGID;
+    }
+#endif
+    return -1;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-s translation|twist|mixed|jitter|desync|flick|spin|gestures|all] [-r rate_hz] [-n frames] [-b batch_frames] "
+            "[-t trace_file] [-c capture_file] [-e heuristic|rigid]\n",
+            argv0);
+}
+
+int main(const int argc, char **argv) {
+    int scenario = -1;
+    uint32_t rate_hz = 1000;
+    size_t frames = 20000;
+    size_t batch = 1;
+    FILE *trace = NULL;
+    FILE *capture = NULL;
+    int estimator = -1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:r:n:b:t:c:e:h")) != -1) {
+        switch (opt) {
+        case 's':
+            scenario = strcmp(optarg, "all") == 0 ? -1 : (int) p2sm_gen_parse(optarg);
+            if (scenario == P2SM_GEN_INVALID) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'r':
+            rate_hz = (uint32_t) strtoul(optarg, NULL, 10);
+            break;
+        case 'n':
+            frames = strtoul(optarg, NULL, 10);
+            break;
+        case 'b':
+            batch = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            trace = fopen(optarg, "w");
+            if (trace == NULL) {
+                perror(optarg);
+                return 1;
+            }
+            break;
+        case 'e':
+            estimator = parse_estimator(optarg);
+            if (estimator < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'c':
+            capture = fopen(optarg, "w");
+            if (capture == NULL) {
+                perror(optarg);
+                return 1;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (rate_hz == 0 || frames == 0 || batch == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    host_set_now_us(HOST_CLOCK_BASE_US);
+    if (host_mixer_init() != 0) {
+        fprintf(stderr, "mixer init failed\n");
+        return 1;
+    }
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    if (estimator >= 0) {
+        p2sm_set_twist_estimator(0, (enum p2sm_twist_estimator) estimator);
+    }
+#endif
+
+    printf("p2sm bench (%s)\n", IS_ENABLED(CONFIG_POINTER_2S_MIXER_FIXED_POINT) ? "fixed-point" : "float");
+    print_timer_overhead();
+    if (scenario < 0) {
+        for (int s = 0; s < P2SM_GEN_COUNT; s++) {
+            bench_stream((enum p2sm_gen_scenario) s, rate_hz, frames, batch, trace, capture);
+        }
+    } else {
+        bench_stream((enum p2sm_gen_scenario) scenario, rate_hz, frames, batch, trace, capture);
+    }
+    bench_stages();
+
+    if (trace != NULL) {
+        fclose(trace);
+    }
+    if (capture != NULL) {
+        fclose(capture);
+    }
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Compares two report traces (p2sm_replay -o, p2sm_bench -t): the running
+// sum of each report code must stay within a tolerance of the other trace's
+// at every timestamp either of them reports at. Used by "make check" to hold
+// the fixed-point build to the float one.
+//
+//   p2sm_cmp [-t counts] [-w notches] [-l lead [-g gap_ms]] reference.txt trace.txt
+//
+// -t bounds REL_X/REL_Y, -w REL_WHEEL (and REL_WHEEL_HI_RES, in notches).
+// Prints the largest drift per code and exits with 1 if one is over.
+//
+// With -l the second trace has prediction on. On REL_X/REL_Y it may run up
+// to lead counts ahead of (or, turning early, behind) the reference while
+// the pointer moves, and has to give all of it back by the end of each
+// gesture: where the reference resumes after more than gap_ms without a
+// report, and at the end, the totals are held to -t.
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum cmp_code { CMP_X, CMP_Y, CMP_WHEEL, CMP_WHEEL_HI_RES, CMP_CODES };
+
+static const char *const cmp_names[CMP_CODES] = { "REL_X", "REL_Y", "REL_WHEEL", "REL_WHEEL_HI_RES" };
+
+struct cmp_rec {
+    int64_t t_us;
+    uint8_t code;
+    int32_t value;
+};
+
+struct cmp_trace {
+    struct cmp_rec *recs;
+    size_t n;
+};
+
+static int load_trace(const char *path, struct cmp_trace *out) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    char line[256], name[32];
+    size_t cap = 0;
+    long long ms, us;
+    int value;
+    memset(out, 0, sizeof(*out));
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "%lld.%lld %31s %d", &ms, &us, name, &value) != 4) {
+            continue;
+        }
+
+        int code = -1;
+        for (int c = 0; c < CMP_CODES; c++) {
+            if (strcmp(name, cmp_names[c]) == 0) {
+                code = c;
+            }
+        }
+        if (code < 0) {
+            continue;
+        }
+
+        if (out->n == cap) {
+            cap = cap ? cap * 2 : 4096;
+            out->recs = realloc(out->recs, cap * sizeof(*out->recs));
+        }
+        out->recs[out->n++] = (struct cmp_rec) { ms * 1000 + us, (uint8_t) code, value };
+    }
+    fclose(f);
+    return 0;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "Usage: %s [-t counts] [-w notches] [-l lead [-g gap_ms]] reference.txt trace.txt\n", argv0);
+}
+
+int main(const int argc, char **argv) {
+    long tol = 1, wheel_tol = 1, lead = -1, gap_ms = 16;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:w:l:g:h")) != -1) {
+        switch (opt) {
+        case 't':
+            tol = strtol(optarg, NULL, 10);
+            break;
+        case 'w':
+            wheel_tol = strtol(optarg, NULL, 10);
+            break;
+        case 'l':
+            lead = strtol(optarg, NULL, 10);
+            break;
+        case 'g':
+            gap_ms = strtol(optarg, NULL, 10);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (optind + 2 != argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    struct cmp_trace tr[2];
+    if (load_trace(argv[optind], &tr[0]) != 0 || load_trace(argv[optind + 1], &tr[1]) != 0) {
+        return 2;
+    }
+
+    const long limit[CMP_CODES] = { tol, tol, wheel_tol, wheel_tol * 120 };
+    int64_t sum[2][CMP_CODES] = { { 0 } };
+    int64_t worst[CMP_CODES] = { 0 }, worst_t[CMP_CODES] = { 0 };
+    size_t i[2] = { 0, 0 };
+
+    // -l: the drift at the end of each gesture, and when the reference last
+    // reported
+    int64_t end[CMP_WHEEL] = { 0 }, end_t[CMP_WHEEL] = { 0 }, last_ref_t = INT64_MIN / 2;
+
+    // both traces up to and including the next timestamp, then compare
+    while (i[0] < tr[0].n || i[1] < tr[1].n) {
+        int64_t t = INT64_MAX;
+        for (int k = 0; k < 2; k++) {
+            if (i[k] < tr[k].n && tr[k].recs[i[k]].t_us < t) {
+                t = tr[k].recs[i[k]].t_us;
+            }
+        }
+        const bool ref_reports = i[0] < tr[0].n && tr[0].recs[i[0]].t_us == t;
+        if (lead >= 0 && ref_reports) {
+            if (t - last_ref_t > gap_ms * 1000) {
+                for (int c = 0; c < CMP_WHEEL; c++) {
+                    const int64_t d = llabs(sum[1][c] - sum[0][c]);
+                    if (d > end[c]) {
+                        end[c] = d;
+                        end_t[c] = t;
+                    }
+                }
+            }
+            last_ref_t = t;
+        }
+        for (int k = 0; k < 2; k++) {
+            for (; i[k] < tr[k].n && tr[k].recs[i[k]].t_us == t; i[k]++) {
+                sum[k][tr[k].recs[i[k]].code] += tr[k].recs[i[k]].value;
+            }
+        }
+
+        for (int c = 0; c < (lead >= 0 ? CMP_WHEEL : CMP_CODES); c++) {
+            const int64_t d = llabs(sum[1][c] - sum[0][c]);
+            if (d > worst[c]) {
+                worst[c] = d;
+                worst_t[c] = t;
+            }
+        }
+    }
+
+    int ret = 0;
+    for (int c = 0; lead >= 0 && c < CMP_WHEEL; c++) {
+        const int64_t d = llabs(sum[1][c] - sum[0][c]);
+        if (d > end[c]) {
+            end[c] = d;
+            end_t[c] = INT64_MAX;
+        }
+        const bool over = worst[c] > lead + tol, left = end[c] > tol;
+        printf("  %-16s %10lld %10lld   max drift %lld at %lld.%03lld ms (limit %ld)%s, at a gesture end %lld",
+               cmp_names[c], (long long) sum[0][c], (long long) sum[1][c], (long long) worst[c],
+               (long long) (worst_t[c] / 1000), (long long) (worst_t[c] % 1000), lead + tol, over ? "  FAIL" : "",
+               (long long) end[c]);
+        if (end_t[c] == INT64_MAX) {
+            printf(" at the end");
+        } else if (end[c] != 0) {
+            printf(" at %lld.%03lld ms", (long long) (end_t[c] / 1000), (long long) (end_t[c] % 1000));
+        }
+        printf(" (limit %ld)%s\n", tol, left ? "  FAIL" : "");
+        ret |= over || left;
+    }
+    for (int c = 0; lead < 0 && c < CMP_CODES; c++) {
+        if (sum[0][c] == 0 && sum[1][c] == 0 && worst[c] == 0) {
+            continue;
+        }
+        const bool over = worst[c] > limit[c];
+        printf("  %-16s %10lld %10lld   max drift %lld at %lld.%03lld ms (limit %ld)%s\n", cmp_names[c],
+               (long long) sum[0][c], (long long) sum[1][c], (long long) worst[c], (long long) (worst_t[c] / 1000),
+               (long long) (worst_t[c] % 1000), limit[c], over ? "  FAIL" : "");
+        ret |= over;
+    }
+
+    free(tr[0].recs);
+    free(tr[1].recs);
+    return ret;
+}
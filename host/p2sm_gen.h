@@ -0,0 +1,202 @@
+#pragma once
+// Synthetic two-sensor event streams for the host tools.
+// Motion is described in the mixer's common (rotated) frame and mapped back to
+// raw per-sensor deltas with the inverse of each sensor's 2x2 projection, so
+// the mixer sees what real sensors mounted at the configured positions would
+// report. Sub-count motion is carried over between frames.
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <dt-bindings/zmk/p2sm.h>
+#include <drivers/input_processor.h>
+
+#define P2SM_GEN_MAX_EVENTS 4
+
+enum p2sm_gen_scenario {
+    P2SM_GEN_TRANSLATION,
+    P2SM_GEN_TWIST,
+    P2SM_GEN_MIXED,
+    P2SM_GEN_JITTER,
+    P2SM_GEN_DESYNC,
+    P2SM_GEN_FLICK,
+    P2SM_GEN_SPIN,
+    P2SM_GEN_GESTURES,
+    P2SM_GEN_COUNT,
+    P2SM_GEN_INVALID = P2SM_GEN_COUNT,
+};
+
+struct p2sm_gen_event {
+    int64_t t_us;
+    uint32_t sensor; // INPUT_MIXER_SENSOR1/2
+    uint16_t code;
+    int32_t value;
+    bool sync;
+};
+
+struct p2sm_gen {
+    enum p2sm_gen_scenario scenario;
+    uint32_t rate_hz;
+    uint64_t frame;
+    float inv[2][2][2];
+    float spin[2][2]; // common-frame motion of each contact point per unit of spin
+    float residue[2][2];
+    double pos[2]; // ground truth, common frame, summed over both sensors as the mixer does
+    uint32_t rng;
+};
+
+static const char *const p2sm_gen_names[P2SM_GEN_COUNT] = {
+    "translation", "twist", "mixed", "jitter", "desync", "flick", "spin", "gestures",
+};
+
+static inline const char *p2sm_gen_name(const enum p2sm_gen_scenario s) {
+    return s < P2SM_GEN_COUNT ? p2sm_gen_names[s] : "invalid";
+}
+
+static inline enum p2sm_gen_scenario p2sm_gen_parse(const char *name) {
+    for (int i = 0; i < P2SM_GEN_COUNT; i++) {
+        if (strcmp(name, p2sm_gen_names[i]) == 0) {
+            return (enum p2sm_gen_scenario) i;
+        }
+    }
+    return P2SM_GEN_INVALID;
+}
+
+// m1/m2: top-left 2x2 of the sensors' projection (raw -> common frame)
+// pos: x/y of the sensors' contact points relative to the ball center
+static inline void p2sm_gen_init(struct p2sm_gen *g, const enum p2sm_gen_scenario scenario, const uint32_t rate_hz,
+                                 const float m1[2][2], const float m2[2][2], const float pos[2][2]) {
+    memset(g, 0, sizeof(*g));
+    g->scenario = scenario;
+    g->rate_hz = rate_hz;
+    g->rng = 0x2545f491u;
+
+    const float (*m[2])[2] = { m1, m2 };
+    for (int s = 0; s < 2; s++) {
+        const float det = m[s][0][0] * m[s][1][1] - m[s][0][1] * m[s][1][0];
+        g->inv[s][0][0] = m[s][1][1] / det;
+        g->inv[s][0][1] = -m[s][0][1] / det;
+        g->inv[s][1][0] = -m[s][1][0] / det;
+        g->inv[s][1][1] = m[s][0][0] / det;
+        // a spin about the vertical axis moves the contact point along the
+        // horizontal tangent, which the rotation onto the bottom keeps
+        g->spin[s][0] = -pos[s][1];
+        g->spin[s][1] = pos[s][0];
+    }
+}
+
+static inline float p2sm_gen_noise(struct p2sm_gen *g, const float amplitude) {
+    g->rng = g->rng * 1664525u + 1013904223u;
+    return ((float) (g->rng >> 8) / (float) (1u << 24) * 2.0f - 1.0f) * amplitude;
+}
+
+// common-frame velocity of each sensor's contact point, counts/s
+static inline void p2sm_gen_velocity(struct p2sm_gen *g, const double t, float v[2][2], bool active[2]) {
+    enum p2sm_gen_scenario sc = g->scenario;
+    active[0] = active[1] = true;
+
+    if (sc == P2SM_GEN_MIXED) {
+        sc = ((uint64_t) (t * 4.0)) % 2 == 0 ? P2SM_GEN_TRANSLATION : P2SM_GEN_TWIST;
+    }
+
+    switch (sc) {
+    case P2SM_GEN_TWIST:
+        v[0][0] = 0;
+        v[0][1] = 3000.0f;
+        v[1][0] = 0;
+        v[1][1] = -3000.0f;
+        break;
+    case P2SM_GEN_SPIN: {
+        // what twisting a real ball does, unlike TWIST which is the pattern
+        // the heuristic looks for; about 3000 counts/s at each sensor
+        const float rho = sqrtf(g->spin[0][0] * g->spin[0][0] + g->spin[0][1] * g->spin[0][1]) +
+                          sqrtf(g->spin[1][0] * g->spin[1][0] + g->spin[1][1] * g->spin[1][1]);
+        const float w = rho > 0 ? 6000.0f / rho : 0;
+        for (int s = 0; s < 2; s++) {
+            v[s][0] = w * g->spin[s][0];
+            v[s][1] = w * g->spin[s][1];
+        }
+        break;
+    }
+    case P2SM_GEN_GESTURES: {
+        // a pointer move, a twist, the twist reversed, a short pause, a twist
+        // and a long pause: every twist state and transition once per 1.9 s
+        // with the default twist and direction filter TTLs
+        const uint32_t ms = (uint32_t) ((uint64_t) (t * 1000.0) % 1900);
+        const float dir = ms < 500 || ms >= 950 ? 1.0f : -1.0f;
+        const bool twist = (ms >= 200 && ms < 800) || (ms >= 950 && ms < 1250);
+        v[0][0] = ms < 200 ? 16000.0f : 0;
+        v[0][1] = twist ? dir * 3000.0f : 0;
+        v[1][0] = v[0][0];
+        v[1][1] = -v[0][1];
+        break;
+    }
+    case P2SM_GEN_JITTER:
+        for (int s = 0; s < 2; s++) {
+            v[s][0] = 150.0f + p2sm_gen_noise(g, 2.0f * (float) g->rate_hz);
+            v[s][1] = -80.0f + p2sm_gen_noise(g, 2.0f * (float) g->rate_hz);
+        }
+        break;
+    case P2SM_GEN_FLICK: {
+        // overflow stress: 20000 counts per sensor and frame (a 20k CPI
+        // sensor moving 1 inch/ms), reversing every 50 ms
+        const float dir = ((uint64_t) (t * 20.0)) % 2 == 0 ? 1.0f : -1.0f;
+        for (int s = 0; s < 2; s++) {
+            v[s][0] = dir * 17320.5f * (float) g->rate_hz;
+            v[s][1] = dir * 10000.0f * (float) g->rate_hz;
+        }
+        break;
+    }
+    case P2SM_GEN_DESYNC:
+        // sensor 2 drops out for 40 ms out of every 200 ms
+        active[1] = ((uint64_t) (t * 1000.0)) % 200 >= 40;
+        // fall through
+    default: {
+        const float angle = (float) t * 0.7f;
+        for (int s = 0; s < 2; s++) {
+            v[s][0] = 4000.0f * cosf(angle);
+            v[s][1] = 4000.0f * sinf(angle);
+        }
+        break;
+    }
+    }
+}
+
+// fills up to P2SM_GEN_MAX_EVENTS events for the next frame, returns the count
+static inline size_t p2sm_gen_next(struct p2sm_gen *g, struct p2sm_gen_event out[P2SM_GEN_MAX_EVENTS]) {
+    const int64_t period_us = 1000000 / g->rate_hz;
+    const int64_t t_us = (int64_t) g->frame * period_us;
+    const double t = (double) t_us / 1e6;
+    float v[2][2];
+    bool active[2];
+    size_t n = 0;
+
+    p2sm_gen_velocity(g, t, v, active);
+    g->frame++;
+    g->pos[0] += (double) (v[0][0] + v[1][0]) / g->rate_hz;
+    g->pos[1] += (double) (v[0][1] + v[1][1]) / g->rate_hz;
+
+    for (int s = 0; s < 2; s++) {
+        const float cx = v[s][0] / (float) g->rate_hz;
+        const float cy = v[s][1] / (float) g->rate_hz;
+        g->residue[s][0] += g->inv[s][0][0] * cx + g->inv[s][0][1] * cy;
+        g->residue[s][1] += g->inv[s][1][0] * cx + g->inv[s][1][1] * cy;
+
+        const int32_t dx = (int32_t) g->residue[s][0];
+        const int32_t dy = (int32_t) g->residue[s][1];
+        g->residue[s][0] -= (float) dx;
+        g->residue[s][1] -= (float) dy;
+
+        if (!active[s] || (dx == 0 && dy == 0)) {
+            continue;
+        }
+
+        // second sensor lags by half a period, as two free-running sensors would
+        const int64_t ts = t_us + (s == 1 ? period_us / 2 : 0);
+        const uint32_t sensor = s == 0 ? INPUT_MIXER_SENSOR1 : INPUT_MIXER_SENSOR2;
+        out[n++] = (struct p2sm_gen_event) { ts, sensor, INPUT_REL_X, dx, false };
+        out[n++] = (struct p2sm_gen_event) { ts, sensor, INPUT_REL_Y, dy, true };
+    }
+
+    return n;
+}
@@ -0,0 +1,265 @@
+// Replays a "p2sm capture dump" through the mixer on a virtual clock and
+// prints every emitted report, one per line, so two builds or two sets of
+// runtime parameters can be compared with diff.
+//
+//   p2sm_replay [-p key=value]... [-o trace.txt] [-e heuristic|rigid] [-P] capture.txt
+//
+// -P turns prediction on, whatever CONFIG_POINTER_2S_MIXER_PREDICT_EN says.
+//
+// The capture file is the shell output as-is; anything outside the
+// cap-begin/cap-end block (prompts, logs) is ignored.
+#include <ctype.h>
+#include <getopt.h>
+#include <stdlib.h>
+
+#include "../src/pointing/pointer_2s_mixer.c"
+#include "host_stubs.h"
+
+#define REPLAY_REC_SIZE 8
+
+struct replay_rec {
+    uint32_t t_us;
+    int16_t value;
+    uint8_t code;
+    uint8_t flags;
+};
+
+static int hex_nibble(const char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static size_t load_capture(FILE *f, struct replay_rec **out) {
+    char line[1024];
+    size_t n = 0, cap = 0;
+    bool in_block = false;
+    struct replay_rec *recs = NULL;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        const char *p = strstr(line, "cap-begin");
+        if (p != NULL) {
+            in_block = true;
+            n = 0; // last block wins
+            continue;
+        }
+        if (strstr(line, "cap-end") != NULL) {
+            in_block = false;
+            continue;
+        }
+        p = strstr(line, "cap ");
+        if (!in_block || p == NULL) {
+            continue;
+        }
+
+        p += 4;
+        uint8_t bytes[REPLAY_REC_SIZE];
+        size_t nb = 0;
+        for (; isxdigit((unsigned char) p[0]) && isxdigit((unsigned char) p[1]); p += 2) {
+            bytes[nb++] = (uint8_t) (hex_nibble(p[0]) << 4 | hex_nibble(p[1]));
+            if (nb < REPLAY_REC_SIZE) {
+                continue;
+            }
+
+            if (n == cap) {
+                cap = cap ? cap * 2 : 1024;
+                recs = realloc(recs, cap * sizeof(*recs));
+            }
+            recs[n++] = (struct replay_rec) {
+                .t_us = (uint32_t) bytes[0] | (uint32_t) bytes[1] << 8 | (uint32_t) bytes[2] << 16 |
+                        (uint32_t) bytes[3] << 24,
+                .value = (int16_t) ((uint16_t) bytes[4] | (uint16_t) bytes[5] << 8),
+                .code = bytes[6],
+                .flags = bytes[7],
+            };
+            nb = 0;
+        }
+    }
+
+    *out = recs;
+    return n;
+}
+
+// twist estimator, -1 if unknown or not built in (RIGID_BODY)
+static int parse_estimator(const char *name) {
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    if (strcmp(name, "heuristic") == 0) {
+        return P2SM_TWIST_HEURISTIC;
+    }
+    if (strcmp(name, "rigid") == 0) {
+        return P2SM_TWIST_RIGID;
+    }
+#endif
+    return -1;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "Usage: %s [-p key=value]... [-o trace.txt] [-e heuristic|rigid] [-P] capture.txt\n", argv0);
+}
+
+int main(const int argc, char **argv) {
+    FILE *trace = stdout;
+    char *params[64];
+    size_t params_cnt = 0;
+    int estimator = -1;
+    bool predict = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "p:o:e:Ph")) != -1) {
+        switch (opt) {
+        case 'p':
+            if (params_cnt < ARRAY_SIZE(params)) {
+                params[params_cnt++] = optarg;
+            }
+            break;
+        case 'e':
+            estimator = parse_estimator(optarg);
+            if (estimator < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'P':
+            predict = true;
+            break;
+        case 'o':
+            trace = fopen(optarg, "w");
+            if (trace == NULL) {
+                perror(optarg);
+                return 1;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[optind], "r");
+    if (in == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    struct replay_rec *recs = NULL;
+    const size_t n = load_capture(in, &recs);
+    fclose(in);
+    if (n == 0) {
+        fprintf(stderr, "no capture records found\n");
+        return 1;
+    }
+
+    host_set_now_us(HOST_CLOCK_BASE_US);
+    if (host_mixer_init() != 0) {
+        fprintf(stderr, "mixer init failed\n");
+        return 1;
+    }
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    if (estimator >= 0) {
+        p2sm_set_twist_estimator(0, (enum p2sm_twist_estimator) estimator);
+    }
+#endif
+    if (predict) {
+        p2sm_set_predict_enabled(0, true);
+    }
+
+    for (size_t i = 0; i < params_cnt; i++) {
+        char *eq = strchr(params[i], '=');
+        if (eq == NULL) {
+            usage(argv[0]);
+            return 1;
+        }
+        *eq = '\0';
+        if (zrc_set(params[i], (int32_t) strtol(eq + 1, NULL, 10)) != 0) {
+            fprintf(stderr, "invalid parameter %s\n", params[i]);
+            return 1;
+        }
+    }
+
+    const struct zmk_input_processor_driver_api *api = host_mixer_dev.api;
+    struct host_report_sink sink = { .trace = trace };
+    host_set_report_sink(&sink);
+
+    // timestamps are 32-bit and may wrap inside a capture
+    int64_t now = HOST_CLOCK_BASE_US;
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0) {
+            now += (uint32_t) (recs[i].t_us - recs[i - 1].t_us);
+        }
+        host_run_until(now);
+
+        struct input_event event = {
+            .type = INPUT_EV_REL,
+            .code = recs[i].code,
+            .value = recs[i].value,
+            .sync = (recs[i].flags & BIT(7)) != 0,
+        };
+        api->handle_event(&host_mixer_dev, &event, recs[i].flags & (INPUT_MIXER_SENSOR1 | INPUT_MIXER_SENSOR2), 0,
+                          NULL);
+    }
+
+    // let pending timers (feedback, filters) expire
+    host_run_until(now + 1000000);
+    host_set_report_sink(NULL);
+
+    fprintf(stderr, "%zu events, %llu reports (x %lld, y %lld, wheel %lld)\n", n, (unsigned long long) sink.reports,
+            (long long) sink.sum_x, (long long) sink.sum_y, (long long) sink.sum_wheel);
+#if P2SM_SCROLL_HI_RES
+    fprintf(stderr, "wheel hi-res %lld\n", (long long) sink.sum_wheel_hi_res);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+    const struct p2sm_stats *st = &((struct zip_pointer_2s_mixer_data *) host_mixer_dev.data)->stats;
+    fprintf(stderr, "sync: %u resets, %u single-sensor fallbacks, %u resyncs\n", st->sync_resets,
+            st->single_sensor_entries, st->dual_resyncs);
+    fprintf(stderr, "twist: %u evaluations, discards:", st->twist_evals);
+    for (int i = 0; i < P2SM_DISCARD_COUNT; i++) {
+        fprintf(stderr, " %u", st->twist_discards[i]);
+    }
+    fprintf(stderr, " (see enum p2sm_twist_discard)\n");
+    fprintf(stderr, "twist transitions:");
+    for (int i = 0; i < P2SM_TWIST_STATE_COUNT; i++) {
+        for (int j = 0; j < P2SM_TWIST_STATE_COUNT; j++) {
+            if (st->twist_transitions[i][j] != 0) {
+                fprintf(stderr, " %d>%d %u", i, j, st->twist_transitions[i][j]);
+            }
+        }
+    }
+    fprintf(stderr, " (see enum p2sm_twist_state)\n");
+    fprintf(stderr, "clipped: %u frame, %u projection, %u twist, %u report\n", st->clipped[P2SM_CLIP_FRAME],
+            st->clipped[P2SM_CLIP_PROJECTION], st->clipped[P2SM_CLIP_TWIST], st->clipped[P2SM_CLIP_REPORT]);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+    fprintf(stderr, "kinetic: %u coasts, %u caught\n", st->coasts, st->coast_catches);
+#endif
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+    struct p2sm_health h;
+    p2sm_health_get(0, &h);
+    fprintf(stderr, "health: flags %x/%x, %u/%u saturations, correlation %d%%\n", h.sensor[0].flags,
+            h.sensor[1].flags, h.sensor[0].saturations, h.sensor[1].saturations, h.correlation);
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+    struct p2sm_adaptive a = { 0 };
+    p2sm_adaptive_get(0, &a);
+    fprintf(stderr, "adaptive: noise %.2f (%u), leak %.2f (%u), twist_thres %u, interference %u\n",
+            a.noise / 256.0, a.noise_samples, a.leak / 256.0, a.leak_samples, a.twist_thres, a.interference);
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+    struct p2sm_queue_stats qs;
+    p2sm_queue_get_stats(0, &qs);
+    fprintf(stderr, "queue: high water %u/%u, %u dropped, %u batches\n", qs.high_water, qs.size, qs.dropped,
+            qs.batches);
+#endif
+
+    if (trace != stdout) {
+        fclose(trace);
+    }
+    free(recs);
+    return 0;
+}
@@ -0,0 +1,442 @@
+// Unit tests for the heuristic twist detector and the 1 euro filter, run by
+// "make check":
+//
+// - every (state, input) cell of twist_table through twist_step(): the next
+//   state, the discard it counts and what it does to the twist bookkeeping
+// - runs of windows: a scroll takes a start and a debounced window after it,
+//   a cooldown or a broken run is debounced again, and the cleanup timeout
+//   is applied by the next window, not by the timer
+// - calculate_twist() on windows several gates would discard, to hold the
+//   order the gates run in
+// - slow strokes ending in a pause with the 1 euro filter on: each one has
+//   to add up to what it does with smoothing off
+// - single-sensor fallback: not on the first motion after a rest or boot,
+//   only when one sensor stays silent while the other keeps moving, with the
+//   same totals as two sensors
+//
+// Prints each failure and exits with 1 if there was one.
+#include <stdlib.h>
+
+// the discard and transition counters are what is being checked
+#undef CONFIG_POINTER_2S_MIXER_STATS
+#define CONFIG_POINTER_2S_MIXER_STATS 1
+#undef CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK
+#define CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK 1
+
+#include "../src/pointing/pointer_2s_mixer.c"
+#include "host_stubs.h"
+
+#define STAYS (-1)
+
+static const char *const input_names[TWIST_IN_COUNT] = {
+    "weak", "translation", "reverse", "interference", "flat", "shaped", "stale", "steady", "settled",
+};
+
+static const char *const state_names[P2SM_TWIST_STATE_COUNT] = {
+    "idle", "candidate", "debouncing", "active", "cooldown",
+};
+
+struct cell_expect {
+    int next; // enum p2sm_twist_state, or STAYS
+    int discard; // enum p2sm_twist_discard, or P2SM_DISCARD_NONE
+    bool touch, restart, latch, reset, emit;
+};
+
+// what each gate's input does in each state, written out cell by cell
+#define C(next, discard, ...) { next, P2SM_DISCARD_##discard, __VA_ARGS__ }
+#define TOUCH .touch = true
+#define RESTART .touch = true, .restart = true
+#define NEW .touch = true, .restart = true, .latch = true, .reset = true
+#define GO .touch = true, .latch = true, .emit = true
+#define IDLE P2SM_TWIST_IDLE
+#define CANDIDATE P2SM_TWIST_CANDIDATE
+#define DEBOUNCING P2SM_TWIST_DEBOUNCING
+#define ACTIVE P2SM_TWIST_ACTIVE
+#define COOLDOWN P2SM_TWIST_COOLDOWN
+
+static const struct cell_expect cell_expect[P2SM_TWIST_STATE_COUNT][TWIST_IN_COUNT] = {
+    [IDLE] = {
+        C(STAYS, TWIST_THRES), C(STAYS, SIGNIFICANT_TRANSLATION), C(CANDIDATE, DIRECTION_FILTER, NEW),
+        C(STAYS, INTERFERENCE, .reset = true), C(STAYS, NONE), C(CANDIDATE, DEBOUNCE, RESTART),
+        C(CANDIDATE, TIME_FILTER, RESTART), C(COOLDOWN, STEADY_COOLDOWN, RESTART), C(CANDIDATE, DEBOUNCE, RESTART),
+    },
+    [CANDIDATE] = {
+        C(STAYS, TWIST_THRES), C(IDLE, SIGNIFICANT_TRANSLATION), C(STAYS, DIRECTION_FILTER, NEW),
+        C(IDLE, INTERFERENCE, .reset = true), C(IDLE, NONE), C(DEBOUNCING, DEBOUNCE, TOUCH),
+        C(STAYS, TIME_FILTER, RESTART), C(COOLDOWN, STEADY_COOLDOWN, RESTART), C(DEBOUNCING, DEBOUNCE, TOUCH),
+    },
+    [DEBOUNCING] = {
+        C(STAYS, TWIST_THRES), C(CANDIDATE, SIGNIFICANT_TRANSLATION, .restart = true),
+        C(CANDIDATE, DIRECTION_FILTER, NEW), C(CANDIDATE, INTERFERENCE, .restart = true, .reset = true),
+        C(CANDIDATE, NONE, .restart = true), C(STAYS, DEBOUNCE, TOUCH), C(CANDIDATE, TIME_FILTER, RESTART),
+        C(COOLDOWN, STEADY_COOLDOWN, RESTART), C(ACTIVE, NONE, GO),
+    },
+    [ACTIVE] = {
+        C(STAYS, TWIST_THRES), C(STAYS, SIGNIFICANT_TRANSLATION), C(CANDIDATE, DIRECTION_FILTER, NEW),
+        C(STAYS, INTERFERENCE, .reset = true), C(STAYS, NONE), C(DEBOUNCING, DEBOUNCE, TOUCH),
+        C(CANDIDATE, TIME_FILTER, RESTART), C(COOLDOWN, STEADY_COOLDOWN, RESTART), C(STAYS, NONE, GO),
+    },
+    [COOLDOWN] = {
+        C(STAYS, TWIST_THRES), C(STAYS, SIGNIFICANT_TRANSLATION), C(CANDIDATE, DIRECTION_FILTER, NEW),
+        C(STAYS, INTERFERENCE, .reset = true), C(STAYS, NONE), C(DEBOUNCING, DEBOUNCE, TOUCH),
+        C(CANDIDATE, TIME_FILTER, RESTART), C(STAYS, STEADY_COOLDOWN, RESTART), C(DEBOUNCING, DEBOUNCE, TOUCH),
+    },
+};
+
+#undef C
+#undef TOUCH
+#undef RESTART
+#undef NEW
+#undef GO
+
+static int failures;
+
+#define EXPECT(cond, fmt, ...)                                                                                         \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            printf("FAIL " fmt ": %s\n", __VA_ARGS__, #cond);                                                          \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// exactly the expected reason counted once, or none
+static bool discards_are(const struct p2sm_stats *st, const int discard) {
+    for (int r = 0; r < P2SM_DISCARD_COUNT; r++) {
+        if (st->twist_discards[r] != (r == discard ? 1u : 0u)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_cells(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params) {
+    const uint32_t before = 1000000, now = 2000000;
+    const int result = 7;
+
+    for (int s = 0; s < P2SM_TWIST_STATE_COUNT; s++) {
+        for (int in = 0; in < TWIST_IN_COUNT; in++) {
+            const struct cell_expect *e = &cell_expect[s][in];
+            const int next = e->next == STAYS ? s : e->next;
+
+            memset(&data->stats, 0, sizeof(data->stats));
+            data->twist_state = (uint8_t) s;
+            data->last_twist = before;
+            data->debounce_start = before;
+            data->last_twist_direction = 0;
+            data->ema_initialized = true;
+
+            const p2sm_num_t out = twist_step(data, params, (enum twist_input) in, true, result, now);
+
+            const char *sn = state_names[s], *inn = input_names[in];
+            EXPECT(data->twist_state == next, "%s + %s: next state %s", sn, inn, state_names[data->twist_state]);
+            EXPECT(discards_are(&data->stats, e->discard), "%s + %s: discard reason", sn, inn);
+            for (int to = 0; to < P2SM_TWIST_STATE_COUNT; to++) {
+                const uint32_t counted = data->stats.twist_transitions[s][to];
+                EXPECT(counted == (to == next && next != s ? 1u : 0u), "%s + %s: transition to %s counted %u", sn,
+                       inn, state_names[to], counted);
+            }
+            EXPECT(data->last_twist == (e->touch ? now : before), "%s + %s: last_twist", sn, inn);
+            EXPECT(data->debounce_start == (e->restart ? now : before), "%s + %s: debounce_start", sn, inn);
+            EXPECT(data->last_twist_direction == (e->latch ? 1 : 0), "%s + %s: direction latch", sn, inn);
+            EXPECT(data->ema_initialized == !e->reset, "%s + %s: averages reset", sn, inn);
+            EXPECT(out == (e->emit ? P2SM_FROM_INT(result) : 0), "%s + %s: output", sn, inn);
+        }
+    }
+}
+
+// runs of windows from a state: each one's next state, and which of them scroll
+struct run_case {
+    const char *name;
+    int from; // enum p2sm_twist_state
+    int in[4]; // enum twist_input, TWIST_IN_COUNT ends the run
+    int state[4]; // enum p2sm_twist_state after each window
+    uint8_t emits; // bit per window
+};
+
+static const struct run_case run_cases[] = {
+    { "start, debounced, scroll", IDLE, { TWIST_IN_STALE, TWIST_IN_SETTLED, TWIST_IN_SETTLED, TWIST_IN_COUNT },
+      { CANDIDATE, DEBOUNCING, ACTIVE }, BIT(2) },
+    { "settled from rest is a start", IDLE, { TWIST_IN_SETTLED, TWIST_IN_SETTLED, TWIST_IN_SETTLED, TWIST_IN_COUNT },
+      { CANDIDATE, DEBOUNCING, ACTIVE }, BIT(2) },
+    { "cooldown is debounced again", COOLDOWN, { TWIST_IN_SETTLED, TWIST_IN_SETTLED, TWIST_IN_COUNT },
+      { DEBOUNCING, ACTIVE }, BIT(1) },
+    { "translation breaks the run", DEBOUNCING,
+      { TWIST_IN_TRANSLATION, TWIST_IN_SETTLED, TWIST_IN_SETTLED, TWIST_IN_COUNT }, { CANDIDATE, DEBOUNCING, ACTIVE },
+      BIT(2) },
+    { "weak windows do not", DEBOUNCING, { TWIST_IN_WEAK, TWIST_IN_WEAK, TWIST_IN_SETTLED, TWIST_IN_COUNT },
+      { DEBOUNCING, DEBOUNCING, ACTIVE }, BIT(2) },
+    { "scrolling goes on through flat windows", ACTIVE,
+      { TWIST_IN_SETTLED, TWIST_IN_FLAT, TWIST_IN_SETTLED, TWIST_IN_COUNT }, { ACTIVE, ACTIVE, ACTIVE },
+      BIT(0) | BIT(2) },
+    { "pointer motion cools it down", ACTIVE, { TWIST_IN_STEADY, TWIST_IN_STEADY, TWIST_IN_SHAPED, TWIST_IN_SETTLED },
+      { COOLDOWN, COOLDOWN, DEBOUNCING, ACTIVE }, BIT(3) },
+};
+
+static void test_runs(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params) {
+    // no cell goes to ACTIVE from anywhere but DEBOUNCING and ACTIVE
+    for (int s = 0; s < P2SM_TWIST_STATE_COUNT; s++) {
+        for (int in = 0; in < TWIST_IN_COUNT; in++) {
+            EXPECT(twist_table[s][in].next != ACTIVE || s == DEBOUNCING || s == ACTIVE, "%s + %s: straight to active",
+                   state_names[s], input_names[in]);
+        }
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(run_cases); i++) {
+        const struct run_case *c = &run_cases[i];
+        uint32_t now = 3000000;
+        data->twist_state = (uint8_t) c->from;
+        for (int w = 0; w < 4 && c->in[w] != TWIST_IN_COUNT; w++) {
+            now += 8000;
+            const p2sm_num_t out = twist_step(data, params, (enum twist_input) c->in[w], true, 5, now);
+            EXPECT(data->twist_state == c->state[w], "%s, window %d: state %s", c->name, w,
+                   state_names[data->twist_state]);
+            EXPECT((out != 0) == ((c->emits & BIT(w)) != 0), "%s, window %d: output %d", c->name, w,
+                   (int) P2SM_TO_INT(out));
+        }
+    }
+
+    // the timeout only marks the state; the next window moves it, and
+    // counts the move
+    data->twist_state = ACTIVE;
+    data->last_twist_direction = 1;
+    memset(&data->twist_values, 0, sizeof(data->twist_values));
+    memset(&data->stats, 0, sizeof(data->stats));
+    twist_filter_cleanup_work_cb(&data->twist_filter_cleanup_work.work);
+    EXPECT(data->twist_state == ACTIVE, "timeout: state %s before the next window", state_names[data->twist_state]);
+    calculate_twist(&host_mixer_dev, params, 4000000);
+    EXPECT(data->twist_state == IDLE, "timeout: state %s after the next window", state_names[data->twist_state]);
+    EXPECT(data->stats.twist_transitions[ACTIVE][IDLE] == 1, "timeout: %u transitions to idle counted",
+           data->stats.twist_transitions[ACTIVE][IDLE]);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN)
+    EXPECT(data->last_twist_direction == -1, "timeout: direction %d kept", data->last_twist_direction);
+#endif
+}
+
+// a window several gates may discard; the first one in calculate_twist()
+// order has to be the one that decides it
+struct gate_case {
+    const char *name;
+    int16_t s1_x, s1_y, s2_x, s2_y;
+    bool reversed; // against the latched direction
+    bool debouncing; // debounce_start within twist_deb
+    bool stale; // last_twist over twist_ttl ago
+    bool steady; // last_sig_move within steady_cd
+    int in; // enum twist_input
+};
+
+// a plain twist: 120 counts apart on Y, no translation
+#define TWIST_WINDOW 0, 60, 0, -60
+
+static const struct gate_case gate_cases[] = {
+    { "weak before translation", 300, 0, 0, -60, .reversed = true, .in = TWIST_IN_WEAK },
+    { "translation before reverse", 300, 60, 0, -60, .reversed = true, .in = TWIST_IN_TRANSLATION },
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN)
+    { "reverse before the averages", TWIST_WINDOW, .reversed = true, .debouncing = true, .stale = true,
+      .steady = true, .in = TWIST_IN_REVERSE },
+#endif
+    // 200 on X is not over the window gate, 220 in all is over the average one
+    { "interference before debounce", 100, 60, 100, -40, .debouncing = true, .stale = true, .steady = true,
+      .in = TWIST_IN_INTERFERENCE },
+    { "flat before debounce", 50, 5, 50, -5, .debouncing = true, .stale = true, .steady = true, .in = TWIST_IN_FLAT },
+    { "debounce before time filter and steady cooldown", TWIST_WINDOW, .debouncing = true, .stale = true,
+      .steady = true, .in = TWIST_IN_SHAPED },
+    { "time filter before steady cooldown", TWIST_WINDOW, .stale = true, .steady = true, .in = TWIST_IN_STALE },
+    { "steady cooldown", TWIST_WINDOW, .steady = true, .in = TWIST_IN_STEADY },
+    { "settled", TWIST_WINDOW, .in = TWIST_IN_SETTLED },
+};
+
+static void test_gate_order(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params) {
+    const uint32_t now = 10000000;
+    const uint32_t deb = P2SM_MS(params->twist_deb), ttl = P2SM_MS(params->twist_ttl);
+    const uint32_t cd = P2SM_MS(params->steady_cd);
+
+    for (size_t i = 0; i < ARRAY_SIZE(gate_cases); i++) {
+        const struct gate_case *c = &gate_cases[i];
+        const bool direction = c->s1_y < c->s2_y;
+
+        for (int s = 0; s < P2SM_TWIST_STATE_COUNT; s++) {
+            const struct cell_expect *e = &cell_expect[s][c->in];
+            memset(&data->stats, 0, sizeof(data->stats));
+            data->twist_state = (uint8_t) s;
+            data->last_twist_direction = (int8_t) (c->reversed ? !direction : direction);
+            data->ema_initialized = false;
+            data->debounce_start = c->debouncing ? now - 1 : now - deb;
+            data->last_twist = c->stale ? now - ttl - 1 : now - 1;
+            data->last_sig_move = c->steady ? now - 1 : now - cd;
+            data->twist_values.s1_x = c->s1_x;
+            data->twist_values.s1_y = c->s1_y;
+            data->twist_values.s2_x = c->s2_x;
+            data->twist_values.s2_y = c->s2_y;
+
+            const p2sm_num_t out = calculate_twist(&host_mixer_dev, params, now);
+
+            const int next = e->next == STAYS ? s : e->next;
+            EXPECT(discards_are(&data->stats, e->discard), "%s (from %s): discard reason", c->name, state_names[s]);
+            EXPECT(data->twist_state == next, "%s (from %s): next state %s", c->name, state_names[s],
+                   state_names[data->twist_state]);
+            EXPECT((out != 0) == e->emit, "%s (from %s): output %d", c->name, state_names[s], (int) P2SM_TO_INT(out));
+        }
+    }
+}
+
+// slow, uneven strokes the filter holds back most of, each ending in a pause
+struct stroke {
+    int16_t dx, dy; // per sensor, every third frame
+    uint16_t frames;
+};
+
+static const struct stroke strokes[] = {
+    { 4, 0, 60 }, { 3, 3, 45 }, { 6, -2, 30 }, { 0, -4, 90 }, { -9, 5, 24 }, { 12, 10, 12 },
+};
+
+#define STROKE_FRAME_US 4000
+#define STROKE_PAUSE_US 300000
+
+static void run_strokes(const enum p2sm_smooth_mode mode, int64_t *now, int64_t sums[][2]) {
+    const struct zmk_input_processor_driver_api *api = host_mixer_dev.api;
+    struct host_report_sink sink = { 0 };
+
+    p2sm_set_smooth_mode(0, mode);
+    host_set_report_sink(&sink);
+    for (size_t i = 0; i < ARRAY_SIZE(strokes); i++) {
+        const int64_t x0 = sink.sum_x, y0 = sink.sum_y;
+        for (uint16_t f = 0; f < strokes[i].frames; f++) {
+            const bool on = f % 3 == 0;
+            const struct {
+                uint16_t code;
+                int16_t value;
+                uint32_t sensor;
+                bool sync;
+            } ev[] = {
+                { INPUT_REL_X, on ? strokes[i].dx : 0, INPUT_MIXER_SENSOR1, false },
+                { INPUT_REL_Y, on ? strokes[i].dy : 0, INPUT_MIXER_SENSOR1, true },
+                { INPUT_REL_X, on ? strokes[i].dx : 0, INPUT_MIXER_SENSOR2, false },
+                { INPUT_REL_Y, on ? strokes[i].dy : 0, INPUT_MIXER_SENSOR2, true },
+            };
+            *now += STROKE_FRAME_US;
+            host_run_until(*now);
+            for (size_t e = 0; e < ARRAY_SIZE(ev); e++) {
+                struct input_event event = {
+                    .type = INPUT_EV_REL, .code = ev[e].code, .value = ev[e].value, .sync = ev[e].sync,
+                };
+                api->handle_event(&host_mixer_dev, &event, ev[e].sensor, 0, NULL);
+            }
+        }
+        *now += STROKE_PAUSE_US;
+        host_run_until(*now);
+        sums[i][0] = sink.sum_x - x0;
+        sums[i][1] = sink.sum_y - y0;
+    }
+    host_set_report_sink(NULL);
+}
+
+static void test_one_euro(void) {
+    int64_t now = 20000000, plain[ARRAY_SIZE(strokes)][2], smooth[ARRAY_SIZE(strokes)][2];
+
+    // pointer motion only
+    if (p2sm_twist_enabled(0)) {
+        p2sm_toggle_twist(0);
+    }
+    run_strokes(P2SM_SMOOTH_OFF, &now, plain);
+    run_strokes(P2SM_SMOOTH_ONE_EURO, &now, smooth);
+    p2sm_set_smooth_mode(0, P2SM_SMOOTH_OFF);
+
+    for (size_t i = 0; i < ARRAY_SIZE(strokes); i++) {
+        EXPECT(smooth[i][0] == plain[i][0] && smooth[i][1] == plain[i][1],
+               "stroke %zu: 1 euro adds up to %lld, %lld, smoothing off to %lld, %lld", i, (long long) smooth[i][0],
+               (long long) smooth[i][1], (long long) plain[i][0], (long long) plain[i][1]);
+    }
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC)
+#define FALLBACK_FRAME_US 4000
+#define FALLBACK_FRAMES 30
+
+// FALLBACK_FRAMES of (dx, 0) from the sensors in mask, then a rest; the
+// pointer's x total
+static int64_t fallback_stroke(int64_t *now, const uint32_t mask, const int16_t dx) {
+    const struct zmk_input_processor_driver_api *api = host_mixer_dev.api;
+    struct host_report_sink sink = { 0 };
+
+    host_set_report_sink(&sink);
+    for (uint16_t f = 0; f < FALLBACK_FRAMES; f++) {
+        *now += FALLBACK_FRAME_US;
+        host_run_until(*now);
+        for (uint32_t sensor = INPUT_MIXER_SENSOR1; sensor <= INPUT_MIXER_SENSOR2; sensor <<= 1) {
+            if (!(mask & sensor)) {
+                continue;
+            }
+            struct input_event x = { .type = INPUT_EV_REL, .code = INPUT_REL_X, .value = dx, .sync = false };
+            struct input_event y = { .type = INPUT_EV_REL, .code = INPUT_REL_Y, .value = 0, .sync = true };
+            api->handle_event(&host_mixer_dev, &x, sensor, 0, NULL);
+            api->handle_event(&host_mixer_dev, &y, sensor, 0, NULL);
+        }
+    }
+    *now += STROKE_PAUSE_US;
+    host_run_until(*now);
+    host_set_report_sink(NULL);
+    return sink.sum_x;
+}
+
+static void test_fallback(struct zip_pointer_2s_mixer_data *data) {
+    const uint32_t both = INPUT_MIXER_SENSOR1 | INPUT_MIXER_SENSOR2;
+    int64_t now = 40000000;
+
+    memset(&data->stats, 0, sizeof(data->stats));
+    const int64_t dual = fallback_stroke(&now, both, 5);
+    EXPECT(data->stats.single_sensor_entries == 0, "rest, both: %u fallbacks", data->stats.single_sensor_entries);
+
+    // boot: sensor 2 has not reported yet, sensor 1 alone is no desync
+    data->sensors_seen = 0;
+    fallback_stroke(&now, INPUT_MIXER_SENSOR1, 5);
+    EXPECT(data->single_sensor == 0 && data->stats.single_sensor_entries == 0, "boot: %u fallbacks",
+           data->stats.single_sensor_entries);
+    // and what it sent alone does not come out once both report (the first
+    // event of the stroke still finds sensor 2 missing and is dropped)
+    const int64_t after = fallback_stroke(&now, both, 5);
+    EXPECT(llabs(after - dual) <= 1, "boot: %lld counts after, %lld before", (long long) after, (long long) dual);
+
+    // sensor 2 goes silent while sensor 1 keeps moving. with the same
+    // geometry for both, equal deltas are a pure translation and the mirror
+    // has to add up to what two sensors do. the report that lets out what the
+    // sync window held back comes after the remainder TTL and drops one
+    // remainder, the first frame still reports with half the motion
+    p2sm_coef_t proj[2][2][2];
+    memcpy(proj, data->proj, sizeof(proj));
+    memcpy(data->proj[1], data->proj[0], sizeof(data->proj[0]));
+    const int64_t twin = fallback_stroke(&now, both, 5);
+    memset(&data->stats, 0, sizeof(data->stats));
+    const int64_t single = fallback_stroke(&now, INPUT_MIXER_SENSOR1, 5);
+    EXPECT(data->single_sensor == INPUT_MIXER_SENSOR1 && data->stats.single_sensor_entries == 1,
+           "silence: %u fallbacks", data->stats.single_sensor_entries);
+    EXPECT(llabs(single - twin) <= 3, "silence: %lld counts, %lld with both", (long long) single, (long long) twin);
+
+    fallback_stroke(&now, both, 5);
+    EXPECT(data->single_sensor == 0 && data->stats.dual_resyncs == 1, "back: %u resyncs", data->stats.dual_resyncs);
+    memcpy(data->proj, proj, sizeof(proj));
+}
+#endif
+
+int main(void) {
+    host_set_now_us(HOST_CLOCK_BASE_US);
+    if (host_mixer_init() != 0) {
+        fprintf(stderr, "mixer init failed\n");
+        return 2;
+    }
+    struct zip_pointer_2s_mixer_data *data = host_mixer_dev.data;
+    const struct p2sm_params *params = params_acquire(data);
+
+    test_cells(data, params);
+    test_runs(data, params);
+    test_gate_order(data, params);
+    test_one_euro();
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC)
+    test_fallback(data);
+#endif
+
+    printf("twist: %d cells, %zu runs, %zu gate cases in %d states; 1 euro: %zu strokes;%s %d failures\n",
+           P2SM_TWIST_STATE_COUNT * TWIST_IN_COUNT, ARRAY_SIZE(run_cases), ARRAY_SIZE(gate_cases),
+           P2SM_TWIST_STATE_COUNT, ARRAY_SIZE(strokes),
+           IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC) ? " fallback;" : "", failures);
+    return failures != 0;
+}
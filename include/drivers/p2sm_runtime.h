@@ -2,20 +2,289 @@
 
 void p2sm_sens_driver_init();
 
-float p2sm_get_move_coef();
-float p2sm_get_twist_coef();
-void p2sm_set_move_coef(float coef);
-void p2sm_set_twist_coef(float coef);
-
-bool p2sm_twist_enabled();
-bool p2sm_twist_is_reversed();
-void p2sm_toggle_twist();
-void p2sm_toggle_twist_reverse();
-
-bool p2sm_sma_enabled();
-void p2sm_set_sma_enabled(bool enabled);
-uint8_t p2sm_get_sma_window();
-void p2sm_set_sma_window(uint8_t window_size);
+// inst = devicetree instance number of the mixer
+uint8_t p2sm_num_instances();
+
+float p2sm_get_move_coef(uint8_t inst);
+float p2sm_get_twist_coef(uint8_t inst);
+void p2sm_set_move_coef(uint8_t inst, float coef);
+void p2sm_set_twist_coef(uint8_t inst, float coef);
+
+bool p2sm_twist_enabled(uint8_t inst);
+bool p2sm_twist_is_reversed(uint8_t inst);
+void p2sm_toggle_twist(uint8_t inst);
+void p2sm_toggle_twist_reverse(uint8_t inst);
+
+bool p2sm_sma_enabled(uint8_t inst);
+void p2sm_set_sma_enabled(uint8_t inst, bool enabled);
+uint8_t p2sm_get_sma_window(uint8_t inst);
+void p2sm_set_sma_window(uint8_t inst, uint8_t window_size);
+
+enum p2sm_smooth_mode {
+    P2SM_SMOOTH_OFF,
+    P2SM_SMOOTH_SMA,
+    P2SM_SMOOTH_ONE_EURO,
+    P2SM_SMOOTH_COUNT,
+};
+
+// tunables come from runtime config (p2sm/oe_*), shared by all instances
+struct p2sm_one_euro_config {
+    uint16_t min_cutoff; // 0.1 Hz
+    uint16_t beta; // 0.1 Hz of cutoff per count/ms of speed
+    uint16_t d_cutoff; // 0.1 Hz
+};
+
+// p2sm_set_sma_enabled() is a shorthand for switching between OFF and SMA
+enum p2sm_smooth_mode p2sm_get_smooth_mode(uint8_t inst);
+void p2sm_set_smooth_mode(uint8_t inst, enum p2sm_smooth_mode mode);
+bool p2sm_one_euro_get_config(uint8_t inst, struct p2sm_one_euro_config *out);
+
+// tunables come from runtime config (p2sm/pred_*), shared by all instances
+struct p2sm_predict_config {
+    uint16_t horizon_us;
+    uint8_t alpha; // velocity EMA, N/100
+    uint8_t max_lead; // counts
+};
+
+bool p2sm_predict_enabled(uint8_t inst);
+void p2sm_set_predict_enabled(uint8_t inst, bool enabled);
+bool p2sm_predict_get_config(uint8_t inst, struct p2sm_predict_config *out);
+
+// same values as the accel-curve devicetree property
+enum p2sm_accel_curve {
+    P2SM_ACCEL_OFF,
+    P2SM_ACCEL_POINTS,
+    P2SM_ACCEL_SIGMOID,
+    P2SM_ACCEL_COUNT,
+};
+
+#define P2SM_ACCEL_MAX_POINTS 8
+
+// speed is mixed counts/ms before move_coef
+struct p2sm_accel_point {
+    uint16_t speed; // 0.1 counts/ms, ascending
+    uint16_t gain; // %
+};
+
+// top and sigmoid tunables come from runtime config (p2sm/accel_*), shared by all instances
+struct p2sm_accel_config {
+    enum p2sm_accel_curve curve;
+    uint16_t top; // 0.1 counts/ms, end of the lookup table
+    uint16_t sigmoid_gain; // %
+    uint16_t sigmoid_mid, sigmoid_width; // 0.1 counts/ms
+    uint8_t num_points;
+    struct p2sm_accel_point points[P2SM_ACCEL_MAX_POINTS];
+};
+
+enum p2sm_accel_curve p2sm_get_accel_curve(uint8_t inst);
+void p2sm_set_accel_curve(uint8_t inst, enum p2sm_accel_curve curve);
+// -EINVAL if there are too many points or speeds are not ascending
+int p2sm_set_accel_points(uint8_t inst, const struct p2sm_accel_point *points, uint8_t num_points);
+bool p2sm_accel_get_config(uint8_t inst, struct p2sm_accel_config *out);
+// gain the input path applies at this speed (0.1 counts/ms), %
+uint16_t p2sm_accel_gain_at(uint8_t inst, uint16_t speed);
+
+#define P2SM_EVENT_SYNC BIT(7)
+
+// one sensor event for p2sm_mix_batch()
+struct p2sm_event {
+    uint32_t t_us; // p2sm_timestamp() when it was read
+    int16_t value;
+    uint8_t code; // INPUT_REL_X/Y
+    uint8_t flags; // INPUT_MIXER_SENSOR1/2 | P2SM_EVENT_SYNC
+};
+
+// the mixer's clock, usec, wraps
+uint32_t p2sm_timestamp();
+// a burst of events (sensor FIFO, catch-up after a stall) in one pass: one
+// projection per sensor, one report and one twist window for the lot. call
+// from the input thread, -EPERM from any other
+int p2sm_mix_batch(uint8_t inst, const struct p2sm_event *events, size_t count);
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
+// re-read all p2sm/* runtime-config keys now, without waiting for the next poll
+void p2sm_zrc_changed();
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+// poll hook: send what is pending now instead of at the next pacing slot,
+// e.g. from a USB SOF callback or right before a BLE connection event
+void p2sm_report_flush(uint8_t inst);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+enum p2sm_twist_estimator {
+    P2SM_TWIST_HEURISTIC, // per-sensor thresholds, EMAs and DELTA_Y_OVER_TRANS_MAG
+    P2SM_TWIST_RIGID, // least-squares angular velocity of the ball
+    P2SM_TWIST_COUNT,
+};
+
+enum p2sm_twist_estimator p2sm_get_twist_estimator(uint8_t inst);
+void p2sm_set_twist_estimator(uint8_t inst, enum p2sm_twist_estimator est);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+#define P2SM_HEALTH_STALL BIT(0) // sees far less motion than the other sensor
+#define P2SM_HEALTH_SATURATED BIT(1) // a delta hit HEALTH_SATURATION
+#define P2SM_HEALTH_NOISY BIT(2) // small motion while the other sensor rests
+
+// |dx|+|dy| per frame: 0, 1, 2-3, 4-7, ... 64+
+#define P2SM_HEALTH_HIST_BUCKETS 8
+
+// counters are per HEALTH_WINDOW_MS window, the last complete one
+struct p2sm_health_sensor {
+    uint8_t flags; // P2SM_HEALTH_*, any of them pauses twist
+    uint16_t rate_hz; // frames
+    uint16_t zero_run; // frames without motion in a row, now
+    uint16_t max_zero_run;
+    uint16_t noise_frames;
+    uint32_t saturations; // since boot
+    uint16_t hist[P2SM_HEALTH_HIST_BUCKETS];
+};
+
+struct p2sm_health {
+    struct p2sm_health_sensor sensor[2];
+    int8_t correlation; // %, of both sensors' projected motion per report; 100 = same motion
+};
+
+bool p2sm_health_get(uint8_t inst, struct p2sm_health *out);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+// learned twist thresholds; quantiles in 1/256 counts per scroll window
+struct p2sm_adaptive {
+    int32_t noise; // |s1_y - s2_y| while resting or translating
+    int32_t leak; // translation while twisting
+    uint32_t noise_samples, leak_samples;
+    uint16_t twist_thres, interference; // in effect, 0 = the configured one
+};
+
+bool p2sm_adaptive_get(uint8_t inst, struct p2sm_adaptive *out);
+// forget what was learned, configured thresholds apply again
+void p2sm_adaptive_reset(uint8_t inst);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+struct p2sm_queue_stats {
+    uint16_t size, used; // records
+    uint16_t high_water; // most records waiting at once
+    uint32_t dropped; // events that found the ring full
+    uint32_t batches; // drain passes of the mixer thread
+};
+
+bool p2sm_queue_get_stats(uint8_t inst, struct p2sm_queue_stats *out);
+void p2sm_queue_reset_stats(uint8_t inst);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+// start -> ROLL_X -> next -> ROLL_Y -> next -> TWIST -> next -> DONE
+enum p2sm_calib_phase {
+    P2SM_CALIB_IDLE,
+    P2SM_CALIB_ROLL_X, // pointer to the right only, lift the finger to go back
+    P2SM_CALIB_ROLL_Y, // pointer down only
+    P2SM_CALIB_TWIST, // optional, either direction
+    P2SM_CALIB_DONE,
+};
+
+struct p2sm_calib_status {
+    enum p2sm_calib_phase phase;
+    uint32_t samples[3]; // ROLL_X, ROLL_Y, TWIST
+};
+
+struct p2sm_calib_result {
+    float matrix[2][2][2]; // per sensor, raw counts -> ball bottom
+    float error[2]; // rms of the fit residual relative to the motion
+};
+
+void p2sm_calib_start(uint8_t inst);
+void p2sm_calib_next(uint8_t inst);
+void p2sm_calib_abort(uint8_t inst);
+bool p2sm_calib_get_status(uint8_t inst, struct p2sm_calib_status *out);
+// in DONE: -EAGAIN if a roll phase has too few samples, -EDOM if they do not span both axes
+int p2sm_calib_solve(uint8_t inst, struct p2sm_calib_result *out);
+// use and persist the last solved matrices instead of the devicetree geometry
+int p2sm_calib_apply(uint8_t inst);
+#endif
+
+// back to the geometry derived from devicetree, undoes p2sm_calib_apply()
+void p2sm_geometry_reset(uint8_t inst);
+bool p2sm_geometry_is_fitted(uint8_t inst);
+
+// where a sum hit its limit and was held there instead of wrapping
+enum p2sm_clip_stage {
+    P2SM_CLIP_FRAME, // raw deltas of one sensor frame, int16
+    P2SM_CLIP_PROJECTION, // projected motion waiting for a report
+    P2SM_CLIP_TWIST, // per-sensor sums between twist evaluations, int16
+    P2SM_CLIP_REPORT, // pointer or wheel value of one report, int16
+    P2SM_CLIP_COUNT,
+};
+
+// why a twist evaluation produced no scroll
+enum p2sm_twist_discard {
+    P2SM_DISCARD_TWIST_THRES,
+    P2SM_DISCARD_SIGNIFICANT_TRANSLATION,
+    P2SM_DISCARD_DIRECTION_FILTER,
+    P2SM_DISCARD_INTERFERENCE,
+    P2SM_DISCARD_DEBOUNCE,
+    P2SM_DISCARD_TIME_FILTER,
+    P2SM_DISCARD_STEADY_COOLDOWN,
+    P2SM_DISCARD_HEALTH,
+    P2SM_DISCARD_COUNT,
+};
+
+// heuristic twist gating, one step per evaluated scroll window
+enum p2sm_twist_state {
+    P2SM_TWIST_IDLE, // nothing twist-shaped lately, direction unknown
+    P2SM_TWIST_CANDIDATE, // first window of a twist, debounce started
+    P2SM_TWIST_DEBOUNCING, // more of it, waiting out twist_deb
+    P2SM_TWIST_ACTIVE, // scrolling
+    P2SM_TWIST_COOLDOWN, // the pointer moved within steady_cd
+    P2SM_TWIST_STATE_COUNT,
+};
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+#define P2SM_STATS_HIST_BUCKETS 16
+
+struct p2sm_stats {
+    uint32_t events_in, frames_in;
+    uint32_t reports_out, wheel_reports_out, wheel_hi_res_reports_out;
+    uint32_t sync_resets, sma_timeouts, params_updates;
+    uint32_t single_sensor_entries, dual_resyncs; // SINGLE_SENSOR_FALLBACK transitions
+    uint32_t twist_evals;
+    uint32_t twist_discards[P2SM_DISCARD_COUNT];
+    uint32_t twist_transitions[P2SM_TWIST_STATE_COUNT][P2SM_TWIST_STATE_COUNT]; // [from][to]
+    uint32_t coasts, coast_catches; // KINETIC_SCROLL starts, and stops by ball motion
+    uint32_t clipped[P2SM_CLIP_COUNT];
+
+    // handle_event duration, hw cycles
+    uint64_t cycles_total;
+    uint32_t cycles_max;
+    uint32_t cycles_hist[P2SM_STATS_HIST_BUCKETS];
+};
+
+bool p2sm_stats_get(uint8_t inst, struct p2sm_stats *out);
+void p2sm_stats_reset(uint8_t inst);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+#define P2SM_CAPTURE_SYNC BIT(7)
+
+// 8 bytes, serialized little endian by the shell dump
+struct p2sm_capture_rec {
+    uint32_t t_us;
+    int16_t value;
+    uint8_t code;
+    uint8_t flags; // INPUT_MIXER_SENSOR1/2 | P2SM_CAPTURE_SYNC
+};
+
+void p2sm_capture_start(uint8_t inst);
+void p2sm_capture_stop(uint8_t inst);
+void p2sm_capture_clear(uint8_t inst);
+bool p2sm_capture_active(uint8_t inst);
+uint16_t p2sm_capture_count(uint8_t inst);
+uint32_t p2sm_capture_dropped(uint8_t inst);
+bool p2sm_capture_get(uint8_t inst, uint16_t idx, struct p2sm_capture_rec *out);
+#endif
 
 struct p2sm_sens_behavior_config {
     uint16_t step;
@@ -6,5 +6,9 @@
 #define INPUT_MIXER_SENSOR1 BIT(0)
 #define INPUT_MIXER_SENSOR2 BIT(1)
 
+// sensorN-flip
+#define P2SM_FLIP_X BIT(0)
+#define P2SM_FLIP_Y BIT(1)
+
 #define P2SM_INC BIT(0)
 #define P2SM_DEC BIT(1)
@@ -28,6 +28,7 @@ static void p2sm_sens_save_work_cb(struct k_work *work);
 #endif
 
 struct behavior_p2sm_sens_config {
+    const uint8_t mixer;
     const bool scroll;
     struct p2sm_sens_behavior_config values;
     char* display_name;
@@ -105,7 +106,7 @@ static int p2sm_detect_drift(const char* dev_name, const float min) {
         return 0;
     }
 
-    const float current = cfg->scroll ? p2sm_get_twist_coef() : p2sm_get_move_coef();
+    const float current = cfg->scroll ? p2sm_get_twist_coef(cfg->mixer) : p2sm_get_move_coef(cfg->mixer);
     const int steps_count = (int) (current * 1000.0f / cfg->values.step - .5f);
     const uint16_t d_drift = fabsf(current - (float) steps_count * one_step) * 1000.0f;
 
@@ -128,9 +129,9 @@ static int p2sm_detect_drift(const char* dev_name, const float min) {
 #endif
 
         if (cfg->scroll) {
-            p2sm_set_twist_coef(closest);
+            p2sm_set_twist_coef(cfg->mixer, closest);
         } else {
-            p2sm_set_move_coef(closest);
+            p2sm_set_move_coef(cfg->mixer, closest);
         }
 
         return 1;
@@ -166,11 +167,11 @@ static int on_p2sm_binding_pressed(struct zmk_behavior_binding *binding, struct
     const float max_value = find_max_value(binding->behavior_dev);
     const bool direction = binding->param1 & P2SM_INC;
     const int8_t steps = binding->param2 != 0 ? (int32_t) binding->param2 : 1;
-    float current = cfg->scroll ? p2sm_get_twist_coef() : p2sm_get_move_coef();
+    float current = cfg->scroll ? p2sm_get_twist_coef(cfg->mixer) : p2sm_get_move_coef(cfg->mixer);
 
     if (p2sm_detect_drift(binding->behavior_dev, min_value)) {
         LOG_DBG("Cycling despite drift…");
-        current = cfg->scroll ? p2sm_get_twist_coef() : p2sm_get_move_coef();
+        current = cfg->scroll ? p2sm_get_twist_coef(cfg->mixer) : p2sm_get_move_coef(cfg->mixer);
     }
 
     bool wrapped = false;
@@ -210,9 +211,9 @@ static int on_p2sm_binding_pressed(struct zmk_behavior_binding *binding, struct
 #endif
 
     if (cfg->scroll) {
-        p2sm_set_twist_coef(new_val);
+        p2sm_set_twist_coef(cfg->mixer, new_val);
     } else {
-        p2sm_set_move_coef(new_val);
+        p2sm_set_move_coef(cfg->mixer, new_val);
     }
 
 #if IS_ENABLED(CONFIG_ZMK_FEEDBACK_COMMON)
@@ -298,6 +299,7 @@ static const struct behavior_driver_api behavior_p2sm_sens_driver_api = {
 
 #define P2SM_INST(n)                                                                                  \
     static struct behavior_p2sm_sens_config behavior_p2sm_sens_config_##n = {                         \
+        .mixer = DT_INST_PROP_OR(n, mixer_instance, 0),                                               \
         .scroll = DT_INST_PROP_OR(n, scroll, false),                                                  \
         .display_name = DT_INST_PROP_OR(n, display_name, DEVICE_DT_NAME(n)),                          \
         .values = {                                                                                   \
@@ -17,13 +17,14 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
 
 struct behavior_p2sm_twist_toggle_config {
+    const uint8_t mixer;
     const uint16_t feedback_duration;
 };
 
 static int on_p2sm_twist_toggle_binding_pressed(struct zmk_behavior_binding *binding, struct zmk_behavior_binding_event event) {
     const struct device* dev = zmk_behavior_get_binding(binding->behavior_dev);
     const struct behavior_p2sm_twist_toggle_config *cfg = dev->config;
-    p2sm_toggle_twist();
+    p2sm_toggle_twist(cfg->mixer);
 
 #if IS_ENABLED(CONFIG_ZMK_FEEDBACK_COMMON)
     if (cfg->feedback_duration > 0) {
@@ -50,6 +51,7 @@ static const struct behavior_driver_api behavior_p2sm_twist_toggle_driver_api =
 
 #define P2SM_TWIST_TOGGLE_INST(n)                                                                              \
     static const struct behavior_p2sm_twist_toggle_config behavior_p2sm_twist_toggle_config_##n = {               \
+        .mixer = DT_INST_PROP_OR(n, mixer_instance, 0),                                                       \
         .feedback_duration = DT_INST_PROP_OR(n, feedback_duration, 0),                                        \
     };                                                                                                      \
     BEHAVIOR_DT_INST_DEFINE(n, behavior_p2sm_twist_toggle_init, NULL, NULL,                                   \
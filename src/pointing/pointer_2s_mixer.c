@@ -15,6 +15,7 @@
 #define CONFIG_SETTINGS_RUNTIME true
 #endif
 #include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
 #endif
 
 #if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
@@ -26,100 +27,196 @@
 #define DT_DRV_COMPAT zmk_pointer_2s_mixer
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-static struct device *g_dev = NULL;
+// hot path arithmetic; Q16.16 on cores without FPU, float otherwise
+// conversions to/from float are only allowed outside of the input path
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_FIXED_POINT)
+typedef int32_t p2sm_num_t;
+typedef int64_t p2sm_sum_t;
+#define P2SM_Q                 16
+#define P2SM_ONE               ((p2sm_num_t) 1 << P2SM_Q)
+#define P2SM_FROM_INT(i)       ((p2sm_num_t) ((int32_t) (i) * P2SM_ONE))
+#define P2SM_FROM_FLOAT(f)     ((p2sm_num_t) ((f) * (float) P2SM_ONE))
+#define P2SM_TO_FLOAT(v)       ((float) (v) / (float) P2SM_ONE)
+// truncates toward zero, same as a float -> int cast
+#define P2SM_TO_INT(v)         ((int32_t) ((v) < 0 ? -(-(v) >> P2SM_Q) : (v) >> P2SM_Q))
+#define P2SM_MUL(a, b)         ((p2sm_num_t) (((int64_t) (a) * (b)) >> P2SM_Q))
+#define P2SM_MUL_INT(a, i)     ((p2sm_num_t) ((a) * (int32_t) (i)))
+#define P2SM_DIV_INT(a, n)     ((p2sm_num_t) ((a) / (int32_t) (n)))
+// projection coefficients in Q4.27: at Q16.16 a 20000-count delta would lose
+// a tenth of a count per frame to the last bit of the coefficient
+typedef int32_t p2sm_coef_t;
+#define P2SM_COEF_Q            27
+#define P2SM_COEF_FROM_FLOAT(f) ((p2sm_coef_t) llround(CLAMP((double) (f) * (1 << P2SM_COEF_Q), INT32_MIN, INT32_MAX)))
+#define P2SM_COEF_TO_FLOAT(c)  ((float) ((double) (c) / (1 << P2SM_COEF_Q)))
+#define P2SM_COEF_MUL(a, b)    ((p2sm_coef_t) (((int64_t) (a) * (b) + (1 << (P2SM_COEF_Q - 1))) >> P2SM_COEF_Q))
+// a sum of coefficient * count products, rounded to p2sm_num_t
+#define P2SM_COEF_TO_NUM(w)    (((w) + (1 << (P2SM_COEF_Q - P2SM_Q - 1))) >> (P2SM_COEF_Q - P2SM_Q))
+#else
+typedef float p2sm_num_t;
+typedef float p2sm_sum_t;
+#define P2SM_ONE               1.0f
+#define P2SM_FROM_INT(i)       ((float) (i))
+#define P2SM_FROM_FLOAT(f)     ((float) (f))
+#define P2SM_TO_FLOAT(v)       ((float) (v))
+#define P2SM_TO_INT(v)         ((int32_t) (v))
+#define P2SM_MUL(a, b)         ((a) * (b))
+#define P2SM_MUL_INT(a, i)     ((a) * (float) (i))
+#define P2SM_DIV_INT(a, n)     ((a) / (float) (n))
+typedef float p2sm_coef_t;
+#define P2SM_COEF_FROM_FLOAT(f) ((float) (f))
+#define P2SM_COEF_TO_FLOAT(c)  ((float) (c))
+#define P2SM_COEF_MUL(a, b)    ((a) * (b))
+#define P2SM_COEF_TO_NUM(w)    (w)
+#endif
 
-#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
-static uint32_t g_zrc_cache_last_refresh = 0;
-static bool     g_zrc_cache_initialized  = false;
-#endif
-
-/* pointer path */
-static bool     g_zrc_frame_sync       = (bool)     IS_ENABLED(CONFIG_POINTER_2S_MIXER_FRAME_SYNC);
-static bool     g_zrc_scroll_dis_ptr   = (bool)     IS_ENABLED(CONFIG_POINTER_2S_MIXER_SCROLL_DISABLES_POINTER);
-static uint32_t g_zrc_ptr_after_scroll = (uint32_t) CONFIG_POINTER_2S_MIXER_POINTER_AFTER_SCROLL_ACTIVATION;
-static uint32_t g_zrc_steady_thres     = (uint32_t) CONFIG_POINTER_2S_MIXER_STEADY_THRES;
-
-/* twist/scroll path */
-static bool     g_zrc_twist_global_en  = (bool)     IS_ENABLED(CONFIG_POINTER_2S_MIXER_TWIST_EN);
-static uint32_t g_zrc_twist_ttl        = (uint32_t) CONFIG_POINTER_2S_MIXER_TWIST_FILTER_TTL;
-static bool     g_zrc_twist_hyst_en    = (bool)     IS_ENABLED(CONFIG_POINTER_2S_MIXER_TWIST_HYST_EN);
-static uint16_t g_zrc_twist_hyst_thres = (uint16_t) CONFIG_POINTER_2S_MIXER_TWIST_HYST_THRES;
-static uint16_t g_zrc_twist_thres      = (uint16_t) CONFIG_POINTER_2S_MIXER_TWIST_THRES;
-static uint16_t g_zrc_twist_hyst_mul   = (uint16_t) CONFIG_POINTER_2S_MIXER_TWIST_HYST_MUL;
-static uint16_t g_zrc_dy_mag_mul       = (uint16_t) CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_MUL;
-static uint16_t g_zrc_twist_hyst_div   = (uint16_t) CONFIG_POINTER_2S_MIXER_TWIST_HYST_DIV;
-static uint16_t g_zrc_dy_mag_div       = (uint16_t) CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_DIV;
-static uint8_t  g_zrc_ema_alpha        = (uint8_t)  CONFIG_POINTER_2S_MIXER_EMA_ALPHA;
-static uint32_t g_zrc_twist_deb        = (uint32_t) CONFIG_POINTER_2S_MIXER_TWIST_FILTER_DEBOUNCE;
-static uint32_t g_zrc_steady_cd        = (uint32_t) CONFIG_POINTER_2S_MIXER_STEADY_COOLDOWN;
-static bool     g_zrc_feedback_en      = (bool)     IS_ENABLED(CONFIG_POINTER_2S_MIXER_FEEDBACK_EN);
-static uint16_t g_zrc_fb_thres         = (uint16_t) CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_THRESHOLD;
-static uint32_t g_zrc_fb_max_cont      = (uint32_t) CONFIG_POINTER_2S_MIXER_FEEDBACK_MAX_CONTINUOUS;
-static int32_t  g_zrc_fb_cooldown      = (int32_t)  CONFIG_POINTER_2S_MIXER_FEEDBACK_COOLDOWN;
-static uint32_t g_zrc_fb_dur           = (uint32_t) CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_DURATION;
+#define P2SM_NUM_INST DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)
 
-#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
-#define ZRC_REFRESH_YIELD()                                          \
-    do {                                                             \
-        if (CONFIG_POINTER_2S_MIXER_ZRC_REFRESH_YIELD_US > 0) {      \
-            k_usleep(CONFIG_POINTER_2S_MIXER_ZRC_REFRESH_YIELD_US);  \
-        }                                                            \
-    } while (0)
-#endif
+// hot path clock: read once per event and passed down to every stage.
+// wraps every ~71 minutes, so only differences may be compared
+static inline uint32_t p2sm_now_us(void) {
+    return (uint32_t) k_ticks_to_us_floor64(k_uptime_ticks());
+}
 
-#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
-static const struct zrc_cache_entry {
-    const char *key;
-    void *dst;
-    uint8_t size;
-} zrc_cache_tbl[] = {
-    { "p2sm/frame_sync",       &g_zrc_frame_sync,       sizeof(g_zrc_frame_sync)       },
-    { "p2sm/scroll_dis_ptr",   &g_zrc_scroll_dis_ptr,   sizeof(g_zrc_scroll_dis_ptr)   },
-    { "p2sm/ptr_after_scroll", &g_zrc_ptr_after_scroll, sizeof(g_zrc_ptr_after_scroll) },
-    { "p2sm/steady_thres",     &g_zrc_steady_thres,     sizeof(g_zrc_steady_thres)     },
-    { "p2sm/twist_global_en",  &g_zrc_twist_global_en,  sizeof(g_zrc_twist_global_en)  },
-    { "p2sm/twist_ttl",        &g_zrc_twist_ttl,        sizeof(g_zrc_twist_ttl)        },
-    { "p2sm/twist_hyst_en",    &g_zrc_twist_hyst_en,    sizeof(g_zrc_twist_hyst_en)    },
-    { "p2sm/twist_hyst_thres", &g_zrc_twist_hyst_thres, sizeof(g_zrc_twist_hyst_thres) },
-    { "p2sm/twist_thres",      &g_zrc_twist_thres,      sizeof(g_zrc_twist_thres)      },
-    { "p2sm/twist_hyst_mul",   &g_zrc_twist_hyst_mul,   sizeof(g_zrc_twist_hyst_mul)   },
-    { "p2sm/twist_dy_mag_mul", &g_zrc_dy_mag_mul,       sizeof(g_zrc_dy_mag_mul)       },
-    { "p2sm/twist_hyst_div",   &g_zrc_twist_hyst_div,   sizeof(g_zrc_twist_hyst_div)   },
-    { "p2sm/twist_dy_mag_div", &g_zrc_dy_mag_div,       sizeof(g_zrc_dy_mag_div)       },
-    { "p2sm/ema_alpha",        &g_zrc_ema_alpha,        sizeof(g_zrc_ema_alpha)        },
-    { "p2sm/twist_deb",        &g_zrc_twist_deb,        sizeof(g_zrc_twist_deb)        },
-    { "p2sm/steady_cd",        &g_zrc_steady_cd,        sizeof(g_zrc_steady_cd)        },
-    { "p2sm/feedback_en",      &g_zrc_feedback_en,      sizeof(g_zrc_feedback_en)      },
-    { "p2sm/fb_thres",         &g_zrc_fb_thres,         sizeof(g_zrc_fb_thres)         },
-    { "p2sm/fb_max_cont",      &g_zrc_fb_max_cont,      sizeof(g_zrc_fb_max_cont)      },
-    { "p2sm/fb_cooldown",      &g_zrc_fb_cooldown,      sizeof(g_zrc_fb_cooldown)      },
-    { "p2sm/fb_dur",           &g_zrc_fb_dur,           sizeof(g_zrc_fb_dur)           },
+// Kconfig and runtime-config durations stay in ms
+#define P2SM_MS(ms) ((uint32_t) (ms) * USEC_PER_MSEC)
+
+// twist scroll output, see POINTER_2S_MIXER_SCROLL_OUTPUT
+#define P2SM_SCROLL_NOTCHES (!IS_ENABLED(CONFIG_POINTER_2S_MIXER_SCROLL_HI_RES))
+#define P2SM_SCROLL_HI_RES (IS_ENABLED(CONFIG_POINTER_2S_MIXER_SCROLL_HI_RES) || IS_ENABLED(CONFIG_POINTER_2S_MIXER_SCROLL_BOTH))
+#define P2SM_HI_RES_PER_NOTCH 120
+
+struct zip_pointer_2s_mixer_data;
+static struct zip_pointer_2s_mixer_data *const g_instances[P2SM_NUM_INST];
+
+
+// gain lookup table of the acceleration curve, see accel_gain()
+#define P2SM_ACCEL_LUT_SIZE 64
+
+// acceleration curve, user; the table is built from it by accel_build()
+struct p2sm_accel_tbl {
+    struct p2sm_accel_point points[P2SM_ACCEL_MAX_POINTS];
+    p2sm_num_t scale; // table entries per count/ms
+    p2sm_num_t lut[P2SM_ACCEL_LUT_SIZE];
 };
-#endif
 
-// even though ZRC_GET is very cheap, it's not free.
-// local cache with polling helps to avoid thousands of reads per sec
-static __attribute__((noinline)) void zrc_cache_refresh_if_due(const uint32_t now) {
-#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
-    if (likely(g_zrc_cache_initialized) &&
-        (now - g_zrc_cache_last_refresh) < CONFIG_POINTER_2S_MIXER_ZRC_POLL_MS) {
-        return;
-    }
+// matrices proj_update() folds into the projection
+struct p2sm_calib_tbl {
+    // per-sensor calibration, devicetree and runtime config combined by calib_build()
+    p2sm_coef_t calib[2][2][2];
+    // fitted by "p2sm calibrate", loaded from settings
+    p2sm_coef_t geom[2][2][2];
+};
 
-    for (size_t i = 0; i < ARRAY_SIZE(zrc_cache_tbl); i++) {
-        const struct zrc_cache_entry *e = &zrc_cache_tbl[i];
-        const int32_t v = zrc_get(e->key);
-        memcpy(e->dst, &v, e->size);
-        if (i + 1 < ARRAY_SIZE(zrc_cache_tbl)) {
-            ZRC_REFRESH_YIELD();
-        }
-    }
+// every tunable the input path reads, never modified once published:
+// the input thread takes one pointer per event and evaluates against a
+// consistent set even if a refresh lands in the middle of it. the tables
+// change rarely and are published separately, the block only points at
+// them, so a setter copies what it changes and no more.
+// fields sorted by size so the block packs without holes
+struct p2sm_params {
+    const struct p2sm_accel_tbl *accel_tbl;
+    const struct p2sm_calib_tbl *calib_tbl;
+    uint32_t version;
+
+    /* user (shell, behaviors, settings) */
+    p2sm_num_t move_coef, twist_coef;
+
+    /* pointer path */
+    uint32_t ptr_after_scroll;
+    uint32_t steady_thres;
+    uint16_t pred_horizon;
+    uint16_t oe_min_cut;
+    uint16_t oe_beta;
+    uint16_t oe_d_cut;
+    uint16_t accel_top;
+    uint16_t accel_gain;
+    uint16_t accel_mid;
+    uint16_t accel_width;
+    uint16_t sens_scale[2]; // %, on top of devicetree
+    int16_t  sens_trim[2]; // 0.1 deg, on top of devicetree
+
+    /* twist/scroll path */
+    uint32_t twist_ttl;
+    uint32_t twist_deb;
+    uint32_t steady_cd;
+    uint32_t fb_max_cont;
+    int32_t  fb_cooldown;
+    uint32_t fb_dur;
+    uint16_t twist_hyst_thres;
+    uint16_t twist_thres;
+    uint16_t twist_hyst_mul;
+    uint16_t dy_mag_mul;
+    uint16_t twist_hyst_div;
+    uint16_t dy_mag_div;
+    uint16_t fb_thres;
+    uint8_t  ema_alpha;
+    uint8_t  pred_alpha;
+    uint8_t  pred_max;
+    uint8_t  sens_flip[2]; // P2SM_FLIP_*, xor devicetree
+
+    /* user */
+    uint8_t  sma_window_size;
+    uint8_t  smooth_mode; // enum p2sm_smooth_mode
+    uint8_t  accel_curve; // enum p2sm_accel_curve
+    uint8_t  accel_npoints;
+    uint8_t  twist_est; // enum p2sm_twist_estimator, RIGID_BODY only
+    bool     twist_enabled, twist_reversed, pred_enabled;
+    bool     geom_fitted; // geom replaces rotation and calib
+
+    /* flags */
+    bool     frame_sync;
+    bool     scroll_dis_ptr;
+    bool     twist_global_en;
+    bool     twist_hyst_en;
+    bool     feedback_en;
+};
 
-    g_zrc_cache_last_refresh = now;
-    g_zrc_cache_initialized  = true;
-#else
-    ARG_UNUSED(now);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+// moving frames the other sensor needs in a window before one can be called stalled
+#define P2SM_HEALTH_MIN_FRAMES 8
 #endif
+
+// going >1 means losing precision
+// acceptable for scroll but not movement
+#define P2SM_PARAMS_DEFAULTS {                                                                   \
+    .move_coef        = MIN(P2SM_DIV_INT(P2SM_FROM_INT(CONFIG_POINTER_2S_MIXER_DEFAULT_MOVE_COEF), 100), P2SM_ONE), \
+    .twist_coef       = P2SM_DIV_INT(P2SM_FROM_INT(CONFIG_POINTER_2S_MIXER_DEFAULT_TWIST_COEF), 100), \
+    .ptr_after_scroll = CONFIG_POINTER_2S_MIXER_POINTER_AFTER_SCROLL_ACTIVATION,                 \
+    .steady_thres     = CONFIG_POINTER_2S_MIXER_STEADY_THRES,                                    \
+    .twist_ttl        = CONFIG_POINTER_2S_MIXER_TWIST_FILTER_TTL,                                \
+    .twist_deb        = CONFIG_POINTER_2S_MIXER_TWIST_FILTER_DEBOUNCE,                           \
+    .steady_cd        = CONFIG_POINTER_2S_MIXER_STEADY_COOLDOWN,                                 \
+    .fb_max_cont      = CONFIG_POINTER_2S_MIXER_FEEDBACK_MAX_CONTINUOUS,                         \
+    .fb_cooldown      = CONFIG_POINTER_2S_MIXER_FEEDBACK_COOLDOWN,                               \
+    .fb_dur           = CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_DURATION,                         \
+    .twist_hyst_thres = CONFIG_POINTER_2S_MIXER_TWIST_HYST_THRES,                                \
+    .twist_thres      = CONFIG_POINTER_2S_MIXER_TWIST_THRES,                                     \
+    .twist_hyst_mul   = CONFIG_POINTER_2S_MIXER_TWIST_HYST_MUL,                                  \
+    .dy_mag_mul       = CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_MUL,                      \
+    .twist_hyst_div   = CONFIG_POINTER_2S_MIXER_TWIST_HYST_DIV,                                  \
+    .dy_mag_div       = CONFIG_POINTER_2S_MIXER_DELTA_Y_OVER_TRANS_MAG_DIV,                      \
+    .fb_thres         = CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_THRESHOLD,                        \
+    .ema_alpha        = CONFIG_POINTER_2S_MIXER_EMA_ALPHA,                                       \
+    .sma_window_size  = CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE,                                 \
+    .pred_horizon     = CONFIG_POINTER_2S_MIXER_PREDICT_HORIZON_US,                              \
+    .oe_min_cut       = CONFIG_POINTER_2S_MIXER_ONE_EURO_MIN_CUTOFF,                             \
+    .oe_beta          = CONFIG_POINTER_2S_MIXER_ONE_EURO_BETA,                                   \
+    .oe_d_cut         = CONFIG_POINTER_2S_MIXER_ONE_EURO_D_CUTOFF,                               \
+    .accel_top        = CONFIG_POINTER_2S_MIXER_ACCEL_TOP,                                       \
+    .accel_gain       = CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_GAIN,                              \
+    .accel_mid        = CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_MID,                               \
+    .accel_width      = CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_WIDTH,                             \
+    .sens_scale       = { 100, 100 },                                                            \
+    .pred_alpha       = CONFIG_POINTER_2S_MIXER_PREDICT_ALPHA,                                   \
+    .pred_max         = CONFIG_POINTER_2S_MIXER_PREDICT_MAX,                                     \
+    .pred_enabled     = IS_ENABLED(CONFIG_POINTER_2S_MIXER_PREDICT_EN),                          \
+    .twist_est        = IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY_DEFAULT), /* P2SM_TWIST_RIGID */ \
+    .twist_enabled    = true,                                                                    \
+    .frame_sync       = IS_ENABLED(CONFIG_POINTER_2S_MIXER_FRAME_SYNC),                          \
+    .scroll_dis_ptr   = IS_ENABLED(CONFIG_POINTER_2S_MIXER_SCROLL_DISABLES_POINTER),             \
+    .twist_global_en  = IS_ENABLED(CONFIG_POINTER_2S_MIXER_TWIST_EN),                            \
+    .twist_hyst_en    = IS_ENABLED(CONFIG_POINTER_2S_MIXER_TWIST_HYST_EN),                       \
+    .feedback_en      = IS_ENABLED(CONFIG_POINTER_2S_MIXER_FEEDBACK_EN),                         \
 }
 
 static void twist_filter_cleanup_work_cb(struct k_work *work);
@@ -129,13 +226,18 @@ static void twist_feedback_extra_delay_work_cb(struct k_work *work);
 static void twist_feedback_cooldown_work_cb(struct k_work *work);
 
 #if IS_ENABLED(CONFIG_SETTINGS)
-static float g_from_settings[2] = { -1, -1 };
-struct k_work_delayable p2sm_save_work;
 static void p2sm_save_work_cb(struct k_work *work);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+static void adapt_save_work_cb(struct k_work *work);
+#endif
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+static void pace_work_cb(struct k_work *work);
 #endif
 
 struct zip_pointer_2s_mixer_config {
-    const uint32_t sync_report_ms, sync_scroll_report_ms;
+    const uint8_t inst;
+    const uint32_t sync_report_us, sync_scroll_report_us;
 
     // CPI and sync window dependent
     const uint16_t twist_interference_thres, twist_interference_window;
@@ -143,47 +245,106 @@ struct zip_pointer_2s_mixer_config {
     // zero (origin) = down left bottom, not the ball center
     const uint8_t sensor1_pos[3], sensor2_pos[3];
     const uint8_t ball_radius; // up to 127
+
+    // per-sensor calibration, applied to the raw counts before the rotation
+    const uint16_t sensor_scale[2]; // %
+    const int16_t sensor_trim[2]; // 0.1 deg, counterclockwise
+    const uint8_t sensor_flip[2]; // P2SM_FLIP_X | P2SM_FLIP_Y
     
     // feedback (i.e. vibration)
     // ToDo refactor to accept any behavior
     const struct gpio_dt_spec feedback_gpios;
     const struct gpio_dt_spec feedback_extra_gpios;
     const uint16_t twist_feedback_delay;
+
+    // initial acceleration curve, until changed at runtime
+    const uint8_t accel_curve, accel_npoints;
+    const uint16_t accel_points[2 * P2SM_ACCEL_MAX_POINTS]; // <speed gain> pairs
 };
 
 struct p2sm_dataframe {
     int16_t s1_x, s1_y, s2_x, s2_y;
 };
 
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+BUILD_ASSERT((CONFIG_POINTER_2S_MIXER_QUEUE_SIZE & (CONFIG_POINTER_2S_MIXER_QUEUE_SIZE - 1)) == 0,
+             "POINTER_2S_MIXER_QUEUE_SIZE must be a power of two");
+#endif
+
 // origin = ball center
 struct zip_pointer_2s_mixer_data {
     const struct device *dev;
     struct k_work_delayable twist_filter_cleanup_work;
 
-    bool initialized, twist_enabled, twist_reversed;
+    bool initialized;
     bool s1_synced, s2_synced;
+    // all timestamps are p2sm_now_us()
     uint32_t last_rpt_time, last_rpt_time_twist;
     int16_t rpt_x, rpt_y;
-    float rpt_x_remainder, rpt_y_remainder, rpt_twist_remainder;
-    float move_coef, twist_coef;
+    p2sm_num_t rpt_x_remainder, rpt_y_remainder, rpt_twist_remainder;
+#if P2SM_SCROLL_HI_RES
+    p2sm_num_t rpt_twist_hr_remainder; // REL_WHEEL_HI_RES units, apart from the notches
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+    // whole counts waiting for the next pacing slot, drained by pace_work
+    struct k_spinlock pace_lock;
+    int32_t paced_x, paced_y, paced_wheel, paced_wheel_hr;
+    atomic_t pace_armed;
+    struct k_work_delayable pace_work;
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+    // one timer for both the release and the coast ticks; kin_lock guards
+    // what the timer shares with the mixing thread
+    struct k_work_delayable kinetic_work;
+    struct k_spinlock kin_lock;
+    p2sm_num_t kin_speed; // notches per tick, reversal applied
+    p2sm_num_t kin_remainder;
+#if P2SM_SCROLL_HI_RES
+    p2sm_num_t kin_hr_remainder;
+#endif
+    p2sm_num_t kin_acc; // twist output since kin_window
+    uint32_t kin_window;
+    bool kin_coasting;
+#endif
 
     struct p2sm_dataframe frame;
-    float rotated_x[2], rotated_y[2];
+    p2sm_num_t rotated_x[2], rotated_y[2];
+    int32_t batch_raw[2][2]; // see batch_flush()
     struct p2sm_dataframe twist_values;
 
-    // pre-calculated
-    float rotation_matrix1[3][3], rotation_matrix2[3][3];
+    // pre-calculated: top-left 2x2 of each sensor's rotation onto the ball bottom
+    p2sm_coef_t rotation[2][2][2];
+    // rotation * calibration, the only matrix the input path applies; see proj_update()
+    p2sm_coef_t proj[2][2][2];
+    uint32_t proj_version;
 
     uint32_t last_twist, debounce_start; // to filter out single events as they are probably accidental
     int8_t last_twist_direction; // to filter out first event in the opposite direction
+    uint8_t twist_state; // enum p2sm_twist_state
+    atomic_t twist_expired; // set by twist_filter_cleanup_work, see twist_expire()
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+    // learned on the mixing thread; adapt_lock guards it and adapt_saved
+    // against the shell and adapt_save_work
+    struct k_spinlock adapt_lock;
+    struct p2sm_adaptive adapt; // see adapt_learn()
+    uint32_t adapt_last;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    uint16_t adapt_saved[2]; // twist_thres and interference as last saved
+    struct k_work_delayable adapt_save_work;
+#endif
+#endif
 
-    float ema_delta_y, ema_translation;
+    p2sm_num_t ema_delta_y, ema_translation;
     bool ema_initialized;
-    bool sma_enabled;
 
     uint32_t last_sig_move;
 #if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC)
     uint32_t last_sensor1_report, last_sensor2_report;
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK)
+    uint8_t single_sensor; // 0 = both, else INPUT_MIXER_SENSOR1/2 carrying on alone
+    uint8_t sensors_seen; // BIT(s) once sensor s has reported, see silent_sensor()
+    uint32_t run_start[2]; // first report after a gap longer than the sync window
+#endif
 #endif
 
     uint32_t twist_accumulator;
@@ -196,84 +357,1096 @@ struct zip_pointer_2s_mixer_data {
     uint32_t feedback_cooldown_until;
     bool feedback_is_in_cooldown;
 
-    float (*sma_buffer)[2];
+    // ring of the last SMA_WINDOW_SIZE_MAX samples, newest at sma_head_index - 1;
+    // sma_sum covers the newest sma_window_size of them, see apply_sma()
+    p2sm_num_t sma_buffer[CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX][2];
+    p2sm_sum_t sma_sum[2];
+#if !IS_ENABLED(CONFIG_POINTER_2S_MIXER_FIXED_POINT)
+    float sma_comp[2];
+#endif
     uint8_t sma_head_index;
     uint8_t sma_count;
-    uint8_t sma_window_size;
+    uint8_t sma_window_size; // the one sma_sum was built for
     uint32_t last_sma_time;
+
+    // see apply_one_euro()
+    p2sm_num_t oe_rate[2]; // counts/ms
+    p2sm_num_t oe_gap[2];
+
+    // see apply_prediction()
+    p2sm_num_t pred_vel_x, pred_vel_y;
+    int16_t pred_lead_x, pred_lead_y; // whole counts
+
+    // see settle_work_cb(); settle_lock guards oe_gap and the lead
+    struct k_spinlock settle_lock;
+    struct k_work_delayable settle_work;
+
+    // see params_acquire() and params_accel()
+    struct p2sm_params params_pool[3];
+    struct p2sm_accel_tbl accel_pool[3];
+    struct p2sm_calib_tbl calib_pool[3];
+    atomic_ptr_t params, params_hazard;
+    struct k_mutex params_lock;
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
+    uint32_t zrc_last_kick;
+#endif
+#if IS_ENABLED(CONFIG_SETTINGS)
+    struct k_work_delayable save_work;
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+    struct p2sm_stats stats;
+    uint32_t params_version;
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+    // see calib_sample()
+    atomic_t calib_phase; // enum p2sm_calib_phase
+    int32_t calib_raw[2][2];
+    struct p2sm_calib_acc {
+        float rxx, rxy, ryy; // sum of r r^T
+        float b[2][2]; // sum of t r^T
+        float tt; // sum of t . t
+    } calib_acc[2];
+    uint32_t calib_samples[3];
+    struct p2sm_calib_result calib_result;
+    bool calib_solved;
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    // rotated (x1 y1 x2 y2) -> (pointer x, pointer y, twist), see rigid_build()
+    p2sm_num_t rigid[3][4];
+    bool rigid_ok; // false if the sensor positions cannot resolve all three axes
+    // since the last twist evaluation
+    p2sm_num_t rigid_twist, rigid_motion;
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+    // see health_roll()
+    struct p2sm_health_acc {
+        uint16_t frames, moving, noise;
+        uint16_t zero_run, max_zero_run;
+        uint16_t hist[P2SM_HEALTH_HIST_BUCKETS];
+        uint16_t last_mag;
+        uint32_t last_frame;
+        uint32_t saturations;
+    } health_acc[2];
+    int64_t health_xy, health_xx, health_yy; // projected motion, per report
+    uint32_t health_window_start;
+    struct p2sm_health health; // last window
+#endif
+
+    k_tid_t input_thread; // last to call handle_event(), see p2sm_mix_batch()
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+    // head is written by the input thread only, tail by the mixer thread only
+    atomic_t queue_head, queue_tail;
+    struct k_work queue_work;
+    uint16_t queue_hwm; // input thread
+    uint32_t queue_dropped; // input thread
+    uint32_t queue_batches; // mixer thread
+    struct p2sm_event queue_buf[CONFIG_POINTER_2S_MIXER_QUEUE_SIZE];
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+    bool capture_active;
+    uint16_t capture_head, capture_count;
+    uint32_t capture_dropped;
+    struct p2sm_capture_rec capture_buf[CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE];
+#endif
 };
 
-static int data_init(const struct device *dev);
-static void apply_rotation(float matrix[3][3], float dx, float dy, float *out_x, float *out_y);
-static void apply_coef(float coef, float *x, float *y);
+// plain increments, no atomics: all writers run on the input thread, or
+// on the mixer thread with POINTER_2S_MIXER_QUEUE
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+#define P2SM_STAT_INC(data, field) ((data)->stats.field++)
+#define P2SM_STAT_DISCARD(data, reason) ((data)->stats.twist_discards[reason]++)
+#define P2SM_STAT_CLIP(data, stage) ((data)->stats.clipped[stage]++)
+#define P2SM_STAT_TRANSITION(data, from, to) ((data)->stats.twist_transitions[from][to]++)
+#else
+#define P2SM_STAT_INC(data, field) ((void) 0)
+#define P2SM_STAT_DISCARD(data, reason) ((void) 0)
+#define P2SM_STAT_CLIP(data, stage) ((void) 0)
+#define P2SM_STAT_TRANSITION(data, from, to) ((void) 0)
+#endif
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+#define P2SM_PERSIST(data) k_work_reschedule(&(data)->save_work, K_MSEC(CONFIG_POINTER_2S_MIXER_SETTINGS_SAVE_DELAY))
+#else
+#define P2SM_PERSIST(data) ((void)0)
+#endif
+
+// saturating sums: a fast flick at high CPI, or frames piling up while the
+// other sensor is late, hold at the limit instead of wrapping into a jump
+// the other way. the frame and twist sums stay int16 to keep the hot part
+// of the data compact
+static inline int16_t sat16(struct zip_pointer_2s_mixer_data *data, const int32_t v,
+                            const enum p2sm_clip_stage stage) {
+    if (unlikely(v > INT16_MAX || v < INT16_MIN)) {
+        P2SM_STAT_CLIP(data, stage);
+        return v > 0 ? INT16_MAX : INT16_MIN;
+    }
+    return (int16_t) v;
+}
+
+static inline int16_t num_to_int16(struct zip_pointer_2s_mixer_data *data, const p2sm_num_t v,
+                                   const enum p2sm_clip_stage stage) {
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_FIXED_POINT)
+    return sat16(data, P2SM_TO_INT(v), stage);
+#else
+    // the cast itself is undefined out of range
+    if (unlikely(v >= 32768.0f || v <= -32769.0f)) {
+        P2SM_STAT_CLIP(data, stage);
+        return v > 0 ? INT16_MAX : INT16_MIN;
+    }
+    return (int16_t) v;
+#endif
+}
+
+// the report range, about all Q16.16 holds; float stops there as well so
+// both builds give the same reports when it is hit
+#define P2SM_NUM_LIMIT P2SM_FROM_INT(INT16_MAX)
+
+static inline p2sm_num_t num_sat(struct zip_pointer_2s_mixer_data *data, const p2sm_sum_t v) {
+    if (unlikely(v > P2SM_NUM_LIMIT || v < -P2SM_NUM_LIMIT)) {
+        P2SM_STAT_CLIP(data, P2SM_CLIP_PROJECTION);
+        return v > 0 ? P2SM_NUM_LIMIT : -P2SM_NUM_LIMIT;
+    }
+    return (p2sm_num_t) v;
+}
+
+static inline p2sm_num_t num_sat_add(struct zip_pointer_2s_mixer_data *data, const p2sm_num_t a, const p2sm_num_t b) {
+    return num_sat(data, (p2sm_sum_t) a + b);
+}
+
+static const struct p2sm_params p2sm_params_defaults = P2SM_PARAMS_DEFAULTS;
+
+// input thread only, once per event; valid until the next call
+static inline const struct p2sm_params *params_acquire(struct zip_pointer_2s_mixer_data *data) {
+    const struct p2sm_params *p;
+    do {
+        p = atomic_ptr_get(&data->params);
+        atomic_ptr_set(&data->params_hazard, (void *) p);
+    } while (unlikely(p != atomic_ptr_get(&data->params)));
+    return p;
+}
+
+// any other thread: a copy of the current block. its table pointers are
+// only good while params_lock is held, see p2sm_accel_get_config()
+static struct p2sm_params params_read(struct zip_pointer_2s_mixer_data *data) {
+    k_mutex_lock(&data->params_lock, K_FOREVER);
+    const struct p2sm_params p = *(const struct p2sm_params *) atomic_ptr_get(&data->params);
+    k_mutex_unlock(&data->params_lock);
+    return p;
+}
+
+// returns a private copy of the current block, to be published with params_publish()
+static struct p2sm_params *params_begin(struct zip_pointer_2s_mixer_data *data) {
+    k_mutex_lock(&data->params_lock, K_FOREVER);
+    const struct p2sm_params *cur = atomic_ptr_get(&data->params);
+    const struct p2sm_params *busy = atomic_ptr_get(&data->params_hazard);
+
+    struct p2sm_params *next = &data->params_pool[0];
+    while (next == cur || next == busy) {
+        next++;
+    }
+
+    *next = *cur;
+    return next;
+}
+
+static void params_publish(struct zip_pointer_2s_mixer_data *data, struct p2sm_params *next) {
+    next->version++;
+    atomic_ptr_set(&data->params, next);
+    k_mutex_unlock(&data->params_lock);
+}
+
+// between params_begin() and params_publish(): a private copy of the table
+// next points at. neither the current block's table nor the one of the
+// block the input thread holds is ever rewritten, so three are enough here
+// as well; a second call returns the same copy
+static struct p2sm_accel_tbl *params_accel(struct zip_pointer_2s_mixer_data *data, struct p2sm_params *next) {
+    const struct p2sm_params *cur = atomic_ptr_get(&data->params);
+    const struct p2sm_params *busy = atomic_ptr_get(&data->params_hazard);
+    const struct p2sm_accel_tbl *held = busy != NULL ? busy->accel_tbl : NULL;
+    if (next->accel_tbl != cur->accel_tbl && next->accel_tbl != held) {
+        return (struct p2sm_accel_tbl *) next->accel_tbl;
+    }
+
+    struct p2sm_accel_tbl *t = &data->accel_pool[0];
+    while (t == cur->accel_tbl || t == held) {
+        t++;
+    }
+    *t = *next->accel_tbl;
+    next->accel_tbl = t;
+    return t;
+}
+
+// same for the calibration matrices
+static struct p2sm_calib_tbl *params_calib(struct zip_pointer_2s_mixer_data *data, struct p2sm_params *next) {
+    const struct p2sm_params *cur = atomic_ptr_get(&data->params);
+    const struct p2sm_params *busy = atomic_ptr_get(&data->params_hazard);
+    const struct p2sm_calib_tbl *held = busy != NULL ? busy->calib_tbl : NULL;
+    if (next->calib_tbl != cur->calib_tbl && next->calib_tbl != held) {
+        return (struct p2sm_calib_tbl *) next->calib_tbl;
+    }
+
+    struct p2sm_calib_tbl *t = &data->calib_pool[0];
+    while (t == cur->calib_tbl || t == held) {
+        t++;
+    }
+    *t = *next->calib_tbl;
+    next->calib_tbl = t;
+    return t;
+}
+
+// gain at speed s (counts/ms), 1.0 = no acceleration
+static float accel_curve_eval(const struct p2sm_params *p, const struct p2sm_accel_point *pt, const float s) {
+    switch (p->accel_curve) {
+    case P2SM_ACCEL_POINTS: {
+        // linear between the points, flat outside of them
+        if (p->accel_npoints == 0) {
+            return 1.0f;
+        }
+        if (s <= pt[0].speed / 10.0f) {
+            return pt[0].gain / 100.0f;
+        }
+        for (uint8_t i = 1; i < p->accel_npoints; i++) {
+            const float s0 = pt[i - 1].speed / 10.0f, s1 = pt[i].speed / 10.0f;
+            if (s < s1) {
+                const float g0 = pt[i - 1].gain / 100.0f, g1 = pt[i].gain / 100.0f;
+                return g0 + (g1 - g0) * (s - s0) / (s1 - s0);
+            }
+        }
+        return pt[p->accel_npoints - 1].gain / 100.0f;
+    }
+    case P2SM_ACCEL_SIGMOID: {
+        // logistic step from 1.0 at rest to accel_gain, centered on accel_mid
+        const float mid = p->accel_mid / 10.0f;
+        const float width = MAX(p->accel_width, 1) / 10.0f;
+        const float lo = 1.0f / (1.0f + expf(mid / width));
+        const float v = 1.0f / (1.0f + expf((mid - s) / width));
+        return 1.0f + (p->accel_gain / 100.0f - 1.0f) * (v - lo) / (1.0f - lo);
+    }
+    default:
+        return 1.0f;
+    }
+}
 
-static void apply_sma(struct zip_pointer_2s_mixer_data *data, float *x, float *y) {
-    if (data == NULL || x == NULL || y == NULL || data->sma_window_size < 2) {
+// writers only, after anything the curve depends on has changed: entry i
+// holds the gain at the middle of [i, i + 1) * accel_top / LUT_SIZE, the
+// last one also covers everything faster
+static void accel_build(const struct p2sm_params *p, struct p2sm_accel_tbl *t) {
+    const float step = MAX(p->accel_top, 1) / 10.0f / P2SM_ACCEL_LUT_SIZE;
+    t->scale = P2SM_FROM_FLOAT(1.0f / step);
+    for (size_t i = 0; i < P2SM_ACCEL_LUT_SIZE; i++) {
+        t->lut[i] = P2SM_FROM_FLOAT(accel_curve_eval(p, t->points, (i + 0.5f) * step));
+    }
+}
+
+// writers only: scale and flip the raw axes, then turn them by the trim
+static void calib_build(const struct zip_pointer_2s_mixer_config *config, const struct p2sm_params *p,
+                        struct p2sm_calib_tbl *t) {
+    for (uint8_t s = 0; s < 2; s++) {
+        const float scale = config->sensor_scale[s] / 100.0f * p->sens_scale[s] / 100.0f;
+        const uint8_t flip = config->sensor_flip[s] ^ p->sens_flip[s];
+        const float fx = (flip & P2SM_FLIP_X) ? -scale : scale;
+        const float fy = (flip & P2SM_FLIP_Y) ? -scale : scale;
+        const float angle = (config->sensor_trim[s] + p->sens_trim[s]) * (float) M_PI / 1800.0f;
+        const float c = cosf(angle), sn = sinf(angle);
+
+        t->calib[s][0][0] = P2SM_COEF_FROM_FLOAT(c * fx);
+        t->calib[s][0][1] = P2SM_COEF_FROM_FLOAT(-sn * fy);
+        t->calib[s][1][0] = P2SM_COEF_FROM_FLOAT(sn * fx);
+        t->calib[s][1][1] = P2SM_COEF_FROM_FLOAT(c * fy);
+    }
+}
+
+// the devicetree curve, as the runtime API would have set it
+static void accel_points_from_config(const struct zip_pointer_2s_mixer_config *config,
+                                     struct p2sm_accel_point points[P2SM_ACCEL_MAX_POINTS]) {
+    for (uint8_t i = 0; i < P2SM_ACCEL_MAX_POINTS; i++) {
+        points[i].speed = config->accel_points[2 * i];
+        points[i].gain = config->accel_points[2 * i + 1];
+    }
+}
+
+static void params_init(struct zip_pointer_2s_mixer_data *data) {
+    const struct zip_pointer_2s_mixer_config *config = data->dev->config;
+    k_mutex_init(&data->params_lock);
+    data->params_pool[0] = p2sm_params_defaults;
+    data->params_pool[0].accel_curve = config->accel_curve;
+    data->params_pool[0].accel_npoints = config->accel_npoints;
+    data->params_pool[0].accel_tbl = &data->accel_pool[0];
+    data->params_pool[0].calib_tbl = &data->calib_pool[0];
+    accel_points_from_config(config, data->accel_pool[0].points);
+    accel_build(&data->params_pool[0], &data->accel_pool[0]);
+    calib_build(config, &data->params_pool[0], &data->calib_pool[0]);
+    atomic_ptr_set(&data->params_hazard, NULL);
+    atomic_ptr_set(&data->params, &data->params_pool[0]);
+}
+
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
+#define ZRC_ENTRY(key, field) { key, offsetof(struct p2sm_params, field), sizeof(((struct p2sm_params *) 0)->field) }
+
+static const struct zrc_cache_entry {
+    const char *key;
+    uint8_t offset, size;
+} zrc_cache_tbl[] = {
+    ZRC_ENTRY("p2sm/frame_sync",       frame_sync),
+    ZRC_ENTRY("p2sm/scroll_dis_ptr",   scroll_dis_ptr),
+    ZRC_ENTRY("p2sm/ptr_after_scroll", ptr_after_scroll),
+    ZRC_ENTRY("p2sm/steady_thres",     steady_thres),
+    ZRC_ENTRY("p2sm/twist_global_en",  twist_global_en),
+    ZRC_ENTRY("p2sm/twist_ttl",        twist_ttl),
+    ZRC_ENTRY("p2sm/twist_hyst_en",    twist_hyst_en),
+    ZRC_ENTRY("p2sm/twist_hyst_thres", twist_hyst_thres),
+    ZRC_ENTRY("p2sm/twist_thres",      twist_thres),
+    ZRC_ENTRY("p2sm/twist_hyst_mul",   twist_hyst_mul),
+    ZRC_ENTRY("p2sm/twist_dy_mag_mul", dy_mag_mul),
+    ZRC_ENTRY("p2sm/twist_hyst_div",   twist_hyst_div),
+    ZRC_ENTRY("p2sm/twist_dy_mag_div", dy_mag_div),
+    ZRC_ENTRY("p2sm/ema_alpha",        ema_alpha),
+    ZRC_ENTRY("p2sm/twist_deb",        twist_deb),
+    ZRC_ENTRY("p2sm/steady_cd",        steady_cd),
+    ZRC_ENTRY("p2sm/feedback_en",      feedback_en),
+    ZRC_ENTRY("p2sm/fb_thres",         fb_thres),
+    ZRC_ENTRY("p2sm/fb_max_cont",      fb_max_cont),
+    ZRC_ENTRY("p2sm/fb_cooldown",      fb_cooldown),
+    ZRC_ENTRY("p2sm/fb_dur",           fb_dur),
+    ZRC_ENTRY("p2sm/pred_horizon",     pred_horizon),
+    ZRC_ENTRY("p2sm/pred_alpha",       pred_alpha),
+    ZRC_ENTRY("p2sm/pred_max",         pred_max),
+    ZRC_ENTRY("p2sm/oe_min_cut",       oe_min_cut),
+    ZRC_ENTRY("p2sm/oe_beta",          oe_beta),
+    ZRC_ENTRY("p2sm/oe_d_cut",         oe_d_cut),
+    ZRC_ENTRY("p2sm/accel_top",        accel_top),
+    ZRC_ENTRY("p2sm/accel_gain",       accel_gain),
+    ZRC_ENTRY("p2sm/accel_mid",        accel_mid),
+    ZRC_ENTRY("p2sm/accel_width",      accel_width),
+    ZRC_ENTRY("p2sm/s1_scale",         sens_scale[0]),
+    ZRC_ENTRY("p2sm/s2_scale",         sens_scale[1]),
+    ZRC_ENTRY("p2sm/s1_trim",          sens_trim[0]),
+    ZRC_ENTRY("p2sm/s2_trim",          sens_trim[1]),
+    ZRC_ENTRY("p2sm/s1_flip",          sens_flip[0]),
+    ZRC_ENTRY("p2sm/s2_flip",          sens_flip[1]),
+};
+
+// even though ZRC_GET is very cheap, it's not free.
+// a poll re-reads the table on the system workqueue and a new params block
+// is published only when a value differs from the last read, so keys
+// written by any tool are picked up within one poll. the input thread never
+// calls ZRC. the keys are shared, every instance gets the same values
+static int32_t g_zrc_snapshot[ARRAY_SIZE(zrc_cache_tbl)];
+static bool    g_zrc_snapshot_valid = false;
+
+static void zrc_refresh_work_cb(struct k_work *work) {
+    int32_t values[ARRAY_SIZE(zrc_cache_tbl)];
+    for (size_t i = 0; i < ARRAY_SIZE(zrc_cache_tbl); i++) {
+        values[i] = zrc_get(zrc_cache_tbl[i].key);
+    }
+
+    if (g_zrc_snapshot_valid && memcmp(values, g_zrc_snapshot, sizeof(values)) == 0) {
         return;
     }
 
-    if (data->sma_buffer == NULL) {
-        data->sma_buffer = malloc(CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX * sizeof(*data->sma_buffer));
-        if (data->sma_buffer == NULL) {
-            LOG_ERR("SMA buffer allocation failed");
-            return;
+    memcpy(g_zrc_snapshot, values, sizeof(values));
+    g_zrc_snapshot_valid = true;
+
+    for (size_t n = 0; n < P2SM_NUM_INST; n++) {
+        struct zip_pointer_2s_mixer_data *data = g_instances[n];
+        struct p2sm_params *next = params_begin(data);
+        for (size_t i = 0; i < ARRAY_SIZE(zrc_cache_tbl); i++) {
+            const struct zrc_cache_entry *e = &zrc_cache_tbl[i];
+            memcpy((uint8_t *) next + e->offset, &values[i], e->size);
         }
-        memset(data->sma_buffer, 0, CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX * sizeof(*data->sma_buffer));
-        data->sma_head_index = 0;
-        data->sma_count = 0;
+        accel_build(next, params_accel(data, next));
+        calib_build(data->dev->config, next, params_calib(data, next));
+        params_publish(data, next);
+    }
+    LOG_DBG("Runtime config applied");
+}
+
+static K_WORK_DEFINE(g_zrc_refresh_work, zrc_refresh_work_cb);
+
+void p2sm_zrc_changed() {
+    k_work_submit(&g_zrc_refresh_work);
+}
+#endif
+
+// polling only while the device is in use
+static inline void zrc_poll(struct zip_pointer_2s_mixer_data *data, const uint32_t now) {
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
+    if (unlikely(now - data->zrc_last_kick >= P2SM_MS(CONFIG_POINTER_2S_MIXER_ZRC_POLL_MS))) {
+        data->zrc_last_kick = now;
+        k_work_submit(&g_zrc_refresh_work);
+    }
+#else
+    ARG_UNUSED(data);
+    ARG_UNUSED(now);
+#endif
+}
+
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+// raw input as it reached the processor, replayable with host/p2sm_replay
+static void capture_event(struct zip_pointer_2s_mixer_data *data, const struct input_event *event, const uint32_t p1,
+                          const uint32_t now) {
+    struct p2sm_capture_rec *rec = &data->capture_buf[data->capture_head];
+    rec->t_us = now;
+    rec->value = (int16_t) CLAMP(event->value, INT16_MIN, INT16_MAX);
+    rec->code = (uint8_t) event->code;
+    rec->flags = (uint8_t) (p1 & (INPUT_MIXER_SENSOR1 | INPUT_MIXER_SENSOR2)) | (event->sync ? P2SM_CAPTURE_SYNC : 0);
+
+    data->capture_head = (data->capture_head + 1) % CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE;
+    if (data->capture_count < CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE) {
+        data->capture_count++;
+    } else {
+        data->capture_dropped++;
+    }
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+// slots are on a fixed grid, so a steady stream lands in every host poll
+// once instead of twice in some and not at all in others
+static void pace_add(struct zip_pointer_2s_mixer_data *data, const int32_t x, const int32_t y, const int32_t wheel,
+                     const int32_t wheel_hr, const uint32_t now) {
+    const k_spinlock_key_t key = k_spin_lock(&data->pace_lock);
+    data->paced_x += x;
+    data->paced_y += y;
+    data->paced_wheel += wheel;
+    data->paced_wheel_hr += wheel_hr;
+    k_spin_unlock(&data->pace_lock, key);
+
+    if (!atomic_test_and_set_bit(&data->pace_armed, 0)) {
+        const uint32_t pace = CONFIG_POINTER_2S_MIXER_REPORT_PACING_US;
+        k_work_schedule(&data->pace_work, K_USEC(pace - now % pace));
+    }
+}
+
+static void pace_flush(struct zip_pointer_2s_mixer_data *data) {
+    // anything added after this point re-arms the timer
+    atomic_clear_bit(&data->pace_armed, 0);
+
+    const k_spinlock_key_t key = k_spin_lock(&data->pace_lock);
+    const int32_t x = data->paced_x, y = data->paced_y, wheel = data->paced_wheel, wheel_hr = data->paced_wheel_hr;
+    data->paced_x = 0;
+    data->paced_y = 0;
+    data->paced_wheel = 0;
+    data->paced_wheel_hr = 0;
+    k_spin_unlock(&data->pace_lock, key);
+
+    // one report: sync on the last code only
+    if (x != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_X, x, y == 0 && wheel == 0 && wheel_hr == 0, K_NO_WAIT);
+        P2SM_STAT_INC(data, reports_out);
+    }
+    if (y != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_Y, y, wheel == 0 && wheel_hr == 0, K_NO_WAIT);
+        P2SM_STAT_INC(data, reports_out);
+    }
+    if (wheel != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_WHEEL, wheel, wheel_hr == 0, K_NO_WAIT);
+        P2SM_STAT_INC(data, wheel_reports_out);
+    }
+    if (wheel_hr != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_WHEEL_HI_RES, wheel_hr, true, K_NO_WAIT);
+        P2SM_STAT_INC(data, wheel_hi_res_reports_out);
+    }
+}
+
+static void pace_work_cb(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    pace_flush(CONTAINER_OF(dwork, struct zip_pointer_2s_mixer_data, pace_work));
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+#define P2SM_KIN_TICK_US P2SM_MS(CONFIG_POINTER_2S_MIXER_KINETIC_TICK_MS)
+// notches/s to notches per tick
+#define P2SM_KIN_SPEED(nps) (P2SM_FROM_INT((nps) * CONFIG_POINTER_2S_MIXER_KINETIC_TICK_MS) / 1000)
+#define P2SM_KIN_KEEP (P2SM_FROM_INT(1000 - CONFIG_POINTER_2S_MIXER_KINETIC_FRICTION) / 1000)
+
+// the ball moving while armed or coasting, from the mixing thread: a
+// significant translation, a twist the other way, or while coasting anything
+static void kinetic_stop(struct zip_pointer_2s_mixer_data *data, const uint32_t now) {
+    k_work_cancel_delayable(&data->kinetic_work);
+
+    const k_spinlock_key_t key = k_spin_lock(&data->kin_lock);
+    const bool coasting = data->kin_coasting;
+    data->kin_coasting = false;
+    data->kin_speed = 0;
+    k_spin_unlock(&data->kin_lock, key);
+
+    if (coasting) {
+        // catching the ball ends a scroll, for SCROLL_DISABLES_POINTER too
+        data->last_rpt_time_twist = now;
+        P2SM_STAT_INC(data, coast_catches);
+    }
+}
+
+// release speed from what the twist stage emits, averaged over windows
+// of at least a tick; armed as long as it is fast enough to coast
+static void kinetic_track(struct zip_pointer_2s_mixer_data *data, const p2sm_num_t twist_val, const uint32_t now) {
+    if (twist_val == 0 && data->kin_acc == 0 && data->kin_speed == 0) {
+        data->kin_window = now;
+        return;
+    }
+
+    const uint32_t elapsed = now - data->kin_window;
+    const bool turned = twist_val != 0 && data->kin_speed != 0 && (twist_val > 0) != (data->kin_speed > 0);
+    if (elapsed > P2SM_MS(CONFIG_POINTER_2S_MIXER_KINETIC_RELEASE_MS) || turned) {
+        // a new twist; twisting back is not letting go of the last one
+        data->kin_window = now;
+        data->kin_acc = twist_val;
+        kinetic_stop(data, now);
+        return;
+    }
+
+    data->kin_acc = num_sat_add(data, data->kin_acc, twist_val);
+    if (elapsed < P2SM_KIN_TICK_US) {
+        return;
+    }
+
+    // zero windows, the ball moving but not twisting, bring it down
+    const p2sm_num_t speed = num_sat(data, (p2sm_sum_t) data->kin_acc * P2SM_KIN_TICK_US / elapsed);
+    data->kin_acc = 0;
+    data->kin_window = now;
+
+    const k_spinlock_key_t key = k_spin_lock(&data->kin_lock);
+    const bool same_way = (speed > 0) == (data->kin_speed > 0);
+    data->kin_speed = same_way ? data->kin_speed / 2 + speed / 2 : speed;
+    const bool armed = data->kin_speed >= P2SM_KIN_SPEED(CONFIG_POINTER_2S_MIXER_KINETIC_START_SPEED) ||
+                       data->kin_speed <= -P2SM_KIN_SPEED(CONFIG_POINTER_2S_MIXER_KINETIC_START_SPEED);
+    k_spin_unlock(&data->kin_lock, key);
+
+    if (armed) {
+        k_work_reschedule(&data->kinetic_work, K_MSEC(CONFIG_POINTER_2S_MIXER_KINETIC_RELEASE_MS));
+    } else {
+        k_work_cancel_delayable(&data->kinetic_work);
+    }
+}
+
+// one tick: constant work, at most one wheel report
+static void kinetic_work_cb(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct zip_pointer_2s_mixer_data *data = CONTAINER_OF(dwork, struct zip_pointer_2s_mixer_data, kinetic_work);
+
+    const k_spinlock_key_t key = k_spin_lock(&data->kin_lock);
+    if (!data->kin_coasting) {
+        // released: coast from the speed it had
+        data->kin_coasting = true;
+        data->kin_remainder = 0;
+#if P2SM_SCROLL_HI_RES
+        data->kin_hr_remainder = 0;
+#endif
+        P2SM_STAT_INC(data, coasts);
+    }
+    const p2sm_num_t speed = P2SM_MUL(data->kin_speed, P2SM_KIN_KEEP);
+    const bool done = speed < P2SM_KIN_SPEED(CONFIG_POINTER_2S_MIXER_KINETIC_STOP_SPEED) &&
+                      speed > -P2SM_KIN_SPEED(CONFIG_POINTER_2S_MIXER_KINETIC_STOP_SPEED);
+    data->kin_speed = done ? 0 : speed;
+    data->kin_coasting = !done;
+
+    data->kin_remainder = num_sat_add(data, data->kin_remainder, speed);
+    const int16_t wheel = num_to_int16(data, data->kin_remainder, P2SM_CLIP_REPORT);
+    data->kin_remainder -= P2SM_FROM_INT(wheel);
+#if P2SM_SCROLL_HI_RES
+    data->kin_hr_remainder =
+        num_sat_add(data, data->kin_hr_remainder, num_sat(data, (p2sm_sum_t) speed * P2SM_HI_RES_PER_NOTCH));
+    const int16_t wheel_hr = num_to_int16(data, data->kin_hr_remainder, P2SM_CLIP_REPORT);
+    data->kin_hr_remainder -= P2SM_FROM_INT(wheel_hr);
+#else
+    const int16_t wheel_hr = 0;
+#endif
+    k_spin_unlock(&data->kin_lock, key);
+
+    if (!done) {
+        k_work_schedule(&data->kinetic_work, K_MSEC(CONFIG_POINTER_2S_MIXER_KINETIC_TICK_MS));
+    }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+    if ((P2SM_SCROLL_NOTCHES && wheel != 0) || wheel_hr != 0) {
+        pace_add(data, 0, 0, P2SM_SCROLL_NOTCHES ? wheel : 0, wheel_hr, p2sm_now_us());
+    }
+#else
+    if (wheel_hr != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_WHEEL_HI_RES, wheel_hr, !P2SM_SCROLL_NOTCHES || wheel == 0,
+                     K_NO_WAIT);
+        P2SM_STAT_INC(data, wheel_hi_res_reports_out);
+    }
+    if (P2SM_SCROLL_NOTCHES && wheel != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_WHEEL, wheel, true, K_NO_WAIT);
+        P2SM_STAT_INC(data, wheel_reports_out);
     }
+#endif
+}
+#endif
+
+static int data_init(const struct device *dev);
+static void project_frame(struct zip_pointer_2s_mixer_data *data, uint8_t s, int32_t dx, int32_t dy);
+static void apply_coef(p2sm_num_t coef, p2sm_num_t *x, p2sm_num_t *y);
+
+#define P2SM_SMA_RING CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX
 
-    const uint32_t now = (uint32_t) k_uptime_get();
-    if (data->sma_count > 0 && now - data->last_sma_time > CONFIG_POINTER_2S_MIXER_SMA_TIMEOUT) {
+// fixed-point sums are exact; float ones carry a Kahan compensation term so
+// that adding and later removing the same values does not drift
+static inline void sma_sum_add(struct zip_pointer_2s_mixer_data *data, const uint8_t axis, const p2sm_num_t v) {
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_FIXED_POINT)
+    data->sma_sum[axis] += v;
+#else
+    const float y = v - data->sma_comp[axis];
+    const float t = data->sma_sum[axis] + y;
+    data->sma_comp[axis] = (t - data->sma_sum[axis]) - y;
+    data->sma_sum[axis] = t;
+#endif
+}
+
+// rebuilds the sums over the newest samples that fit the current window
+static void sma_resum(struct zip_pointer_2s_mixer_data *data) {
+    memset(data->sma_sum, 0, sizeof(data->sma_sum));
+#if !IS_ENABLED(CONFIG_POINTER_2S_MIXER_FIXED_POINT)
+    memset(data->sma_comp, 0, sizeof(data->sma_comp));
+#endif
+    const uint8_t n = MIN(data->sma_count, data->sma_window_size);
+    for (uint8_t k = 1; k <= n; k++) {
+        const uint8_t i = (data->sma_head_index + P2SM_SMA_RING - k) % P2SM_SMA_RING;
+        sma_sum_add(data, 0, data->sma_buffer[i][0]);
+        sma_sum_add(data, 1, data->sma_buffer[i][1]);
+    }
+}
+
+// constant divisors let the compiler turn the power-of-two windows into
+// shifts (fixed point) or exact multiplications (float)
+static inline p2sm_num_t sma_div(const p2sm_sum_t sum, const uint8_t n) {
+    switch (n) {
+    case 2:   return (p2sm_num_t) P2SM_DIV_INT(sum, 2);
+    case 4:   return (p2sm_num_t) P2SM_DIV_INT(sum, 4);
+    case 8:   return (p2sm_num_t) P2SM_DIV_INT(sum, 8);
+    case 16:  return (p2sm_num_t) P2SM_DIV_INT(sum, 16);
+    case 32:  return (p2sm_num_t) P2SM_DIV_INT(sum, 32);
+    case 64:  return (p2sm_num_t) P2SM_DIV_INT(sum, 64);
+    case 128: return (p2sm_num_t) P2SM_DIV_INT(sum, 128);
+    default:  return (p2sm_num_t) P2SM_DIV_INT(sum, n);
+    }
+}
+
+static void apply_sma(struct zip_pointer_2s_mixer_data *data, const uint8_t window_size, const uint32_t now,
+                      p2sm_num_t *x, p2sm_num_t *y) {
+    if (data == NULL || x == NULL || y == NULL || window_size < 2) {
+        return;
+    }
+
+    if (data->sma_count > 0 && now - data->last_sma_time > P2SM_MS(CONFIG_POINTER_2S_MIXER_SMA_TIMEOUT)) {
         data->sma_head_index = 0;
         data->sma_count = 0;
+        memset(data->sma_sum, 0, sizeof(data->sma_sum));
+#if !IS_ENABLED(CONFIG_POINTER_2S_MIXER_FIXED_POINT)
+        memset(data->sma_comp, 0, sizeof(data->sma_comp));
+#endif
         LOG_DBG("SMA history discarded (timeout)");
+        P2SM_STAT_INC(data, sma_timeouts);
+    }
+
+    // the ring always keeps the last SMA_WINDOW_SIZE_MAX samples, so the
+    // history survives a window change in both directions
+    if (unlikely(window_size != data->sma_window_size)) {
+        data->sma_window_size = window_size;
+        sma_resum(data);
     }
 
     data->last_sma_time = now;
+    if (data->sma_count >= window_size) {
+        const uint8_t out = (data->sma_head_index + P2SM_SMA_RING - window_size) % P2SM_SMA_RING;
+        sma_sum_add(data, 0, -data->sma_buffer[out][0]);
+        sma_sum_add(data, 1, -data->sma_buffer[out][1]);
+    }
+
     data->sma_buffer[data->sma_head_index][0] = *x;
     data->sma_buffer[data->sma_head_index][1] = *y;
-    data->sma_head_index = (data->sma_head_index + 1) % data->sma_window_size;
-    if (data->sma_count < data->sma_window_size) {
+    sma_sum_add(data, 0, *x);
+    sma_sum_add(data, 1, *y);
+    data->sma_head_index = (data->sma_head_index + 1) % P2SM_SMA_RING;
+    if (data->sma_count < P2SM_SMA_RING) {
         data->sma_count++;
     }
 
-    if (data->sma_count == data->sma_window_size) {
-        float sum_x = 0.0f, sum_y = 0.0f;
-        for (uint8_t i = 0; i < data->sma_count; i++) {
-            sum_x += data->sma_buffer[i][0];
-            sum_y += data->sma_buffer[i][1];
+    if (data->sma_count >= window_size) {
+        *x = sma_div(data->sma_sum[0], window_size);
+        *y = sma_div(data->sma_sum[1], window_size);
+    }
+}
+
+// first-order low-pass smoothing factor for a cutoff of fc_dhz (0.1 Hz)
+// sampled every dt us: dt / (dt + tau), tau = 1 / (2 pi fc)
+static inline p2sm_num_t lowpass_alpha(const uint32_t fc_dhz, const uint32_t dt) {
+    const p2sm_sum_t a = (p2sm_sum_t) fc_dhz * dt;
+    return (p2sm_num_t) (a * P2SM_ONE / (a + (p2sm_sum_t) 1591549));
+}
+
+// 1 euro filter (Casiez et al.) per axis: a low-pass on position whose
+// cutoff rises with speed, so slow precise motion is smoothed hard and fast
+// motion passes with little lag. speed is the input rate, low-passed at
+// oe_d_cut. only the gap between the measured and the filtered position is
+// kept, and every report moves the output by alpha * gap: nothing is lost,
+// motion the filter holds back is sent with the next reports, or by
+// settle_work once the pointer stops. true when that has to wait for longer
+static bool apply_one_euro(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params,
+                           const uint32_t dt, p2sm_num_t *x, p2sm_num_t *y) {
+    if (dt == 0) {
+        return false;
+    }
+
+    p2sm_num_t *val[2] = { x, y };
+    bool moving = false, holding = false;
+
+    const k_spinlock_key_t key = k_spin_lock(&data->settle_lock);
+    // after a pause the filter starts over, passing this report through
+    // with the whole counts it still held; less than a count is dropped,
+    // as the remainders are
+    if (dt > P2SM_MS(CONFIG_POINTER_2S_MIXER_REMAINDER_TTL)) {
+        for (uint8_t i = 0; i < 2; i++) {
+            data->oe_rate[i] = (p2sm_num_t) ((p2sm_sum_t) *val[i] * USEC_PER_MSEC / (p2sm_sum_t) dt);
+            *val[i] = num_sat_add(data, *val[i], P2SM_FROM_INT(P2SM_TO_INT(data->oe_gap[i])));
+            data->oe_gap[i] = 0;
+        }
+        k_spin_unlock(&data->settle_lock, key);
+        return false;
+    }
+
+    const p2sm_num_t d_alpha = lowpass_alpha(params->oe_d_cut, dt);
+    for (uint8_t i = 0; i < 2; i++) {
+        const p2sm_num_t rate = (p2sm_num_t) ((p2sm_sum_t) *val[i] * USEC_PER_MSEC / (p2sm_sum_t) dt);
+        data->oe_rate[i] += P2SM_MUL(rate - data->oe_rate[i], d_alpha);
+
+        const p2sm_num_t speed = data->oe_rate[i] < 0 ? -data->oe_rate[i] : data->oe_rate[i];
+        const p2sm_sum_t cutoff = (p2sm_sum_t) params->oe_min_cut + (p2sm_sum_t) speed * params->oe_beta / P2SM_ONE;
+        const uint32_t cutoff_dhz = (uint32_t) MIN(cutoff, (p2sm_sum_t) CONFIG_POINTER_2S_MIXER_ONE_EURO_MAX_CUTOFF);
+
+        // whole counts, the fraction would only come back next time. the
+        // pointer moves while the input crosses a count, as it would report
+        const p2sm_num_t held = data->oe_gap[i];
+        data->oe_gap[i] += *val[i];
+        moving |= P2SM_TO_INT(data->oe_gap[i]) != P2SM_TO_INT(held);
+        *val[i] = P2SM_FROM_INT(P2SM_TO_INT(P2SM_MUL(data->oe_gap[i], lowpass_alpha(cutoff_dhz, dt))));
+        data->oe_gap[i] -= *val[i];
+        holding |= data->oe_gap[i] >= P2SM_ONE || data->oe_gap[i] <= -P2SM_ONE;
+    }
+    k_spin_unlock(&data->settle_lock, key);
+    return moving && holding;
+}
+
+// constant-velocity extrapolation to hide the sync window and SMA delay.
+// the report runs ahead of the measured motion by velocity * horizon, in
+// whole counts on top of what would be reported anyway, so the remainders
+// are those of the plain path. that lead is remembered and given back as
+// the motion slows down, so overshoot is bounded by pred_max. once the
+// velocity estimate turns around what is left of it is taken out of this
+// report, and when the pointer stops settle_work takes it back: every
+// stroke ends where it would have without prediction. true when that has
+// to wait for longer
+static bool apply_prediction(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params,
+                             const uint32_t dt, int16_t *x, int16_t *y) {
+    int16_t *val[2] = { x, y };
+    p2sm_num_t *vel[2] = { &data->pred_vel_x, &data->pred_vel_y };
+    int16_t *lead[2] = { &data->pred_lead_x, &data->pred_lead_y };
+    const p2sm_num_t alpha = P2SM_DIV_INT(P2SM_FROM_INT(params->pred_alpha), 100);
+    const p2sm_num_t max_lead = P2SM_FROM_INT(params->pred_max);
+    const bool idle = dt > P2SM_MS(CONFIG_POINTER_2S_MIXER_REMAINDER_TTL);
+    const bool moving = *x != 0 || *y != 0;
+
+    const k_spinlock_key_t key = k_spin_lock(&data->settle_lock);
+    for (uint8_t i = 0; i < 2; i++) {
+        if (dt == 0 || idle) {
+            *vel[i] = 0;
+        } else {
+            // motion over the horizon at the rate of this report
+            const p2sm_num_t v = num_sat(data, (p2sm_sum_t) P2SM_FROM_INT(*val[i]) * params->pred_horizon / dt);
+            *vel[i] += P2SM_MUL(v - *vel[i], alpha);
+        }
+
+        int32_t in = *val[i];
+        if (idle || (*vel[i] < 0 && *lead[i] > 0) || (*vel[i] > 0 && *lead[i] < 0)) {
+            in -= *lead[i];
+            *lead[i] = 0;
+        }
+
+        // less than a count over the horizon is noise at rest, not worth a report
+        const p2sm_num_t ahead = *vel[i] > P2SM_ONE ? *vel[i] - P2SM_ONE : *vel[i] < -P2SM_ONE ? *vel[i] + P2SM_ONE : 0;
+        const int32_t target = P2SM_TO_INT(CLAMP(ahead, -max_lead, max_lead));
+        int32_t out = in + target - *lead[i];
+        if (in >= 0 && out < 0) {
+            out = 0;
+        } else if (in <= 0 && out > 0) {
+            out = 0;
+        }
+        // motion against the lead is taken out of it before the pointer follows
+        if (*lead[i] > 0) {
+            out = MAX(out, MIN(in + *lead[i], 0));
+        } else if (*lead[i] < 0) {
+            out = MIN(out, MAX(in + *lead[i], 0));
         }
 
-        *x = sum_x / (float) data->sma_window_size;
-        *y = sum_y / (float) data->sma_window_size;
+        out = sat16(data, out, P2SM_CLIP_REPORT);
+        *lead[i] = (int16_t) (*lead[i] + out - in);
+        *val[i] = (int16_t) out;
+    }
+    const bool leading = data->pred_lead_x != 0 || data->pred_lead_y != 0;
+    k_spin_unlock(&data->settle_lock, key);
+    return moving && leading;
+}
+
+// no motion for the remainder TTL: the pointer has stopped. the whole
+// counts the 1 euro filter still holds go out and the prediction lead comes
+// back, in one report
+static void settle_work_cb(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct zip_pointer_2s_mixer_data *data = CONTAINER_OF(dwork, struct zip_pointer_2s_mixer_data, settle_work);
+
+    const k_spinlock_key_t key = k_spin_lock(&data->settle_lock);
+    const int32_t gap_x = P2SM_TO_INT(data->oe_gap[0]), gap_y = P2SM_TO_INT(data->oe_gap[1]);
+    data->oe_gap[0] -= P2SM_FROM_INT(gap_x);
+    data->oe_gap[1] -= P2SM_FROM_INT(gap_y);
+    const int32_t x = gap_x - data->pred_lead_x, y = gap_y - data->pred_lead_y;
+    data->pred_lead_x = 0;
+    data->pred_lead_y = 0;
+    k_spin_unlock(&data->settle_lock, key);
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+    if (x != 0 || y != 0) {
+        pace_add(data, x, y, 0, 0, p2sm_now_us());
+    }
+#else
+    if (x != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_X, x, y == 0, K_NO_WAIT);
+        P2SM_STAT_INC(data, reports_out);
+    }
+    if (y != 0) {
+        input_report(data->dev, INPUT_EV_REL, INPUT_REL_Y, y, true, K_NO_WAIT);
+        P2SM_STAT_INC(data, reports_out);
+    }
+#endif
+}
+
+// acceleration gain for the motion of this report: one division for the
+// speed, then a table lookup. the length is max + min / 2, within 12% of
+// the euclidean one. after a pause the motion is spread over the remainder
+// TTL, it has been building up for at least that long
+static inline p2sm_num_t accel_gain(const struct p2sm_params *params, const p2sm_num_t x, const p2sm_num_t y,
+                                    const uint32_t dt) {
+    const p2sm_num_t ax = x < 0 ? -x : x;
+    const p2sm_num_t ay = y < 0 ? -y : y;
+    const p2sm_num_t len = MAX(ax, ay) + P2SM_DIV_INT(MIN(ax, ay), 2);
+    const uint32_t span = CLAMP(dt, 1, P2SM_MS(CONFIG_POINTER_2S_MIXER_REMAINDER_TTL));
+    const p2sm_num_t speed = (p2sm_num_t) ((p2sm_sum_t) len * USEC_PER_MSEC / (p2sm_sum_t) span);
+    const struct p2sm_accel_tbl *t = params->accel_tbl;
+    const p2sm_sum_t idx = (p2sm_sum_t) speed * t->scale / ((p2sm_sum_t) P2SM_ONE * P2SM_ONE);
+    return t->lut[idx < P2SM_ACCEL_LUT_SIZE - 1 ? (size_t) idx : P2SM_ACCEL_LUT_SIZE - 1];
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+static inline bool calib_collecting(const atomic_val_t phase) {
+    return phase >= P2SM_CALIB_ROLL_X && phase <= P2SM_CALIB_TWIST;
+}
+
+// only while "p2sm calibrate" runs, so float is fine. every report adds one
+// sample per sensor to the normal equations of min sum |M r - t|^2, r being
+// the raw counts since the last report and t the motion the phase asks for.
+// rolls: the length the current geometry gives, averaged over both sensors
+// so that a CPI mismatch gets fitted out, along +X or +Y. twist: each sensor
+// keeps its own length and the sign of its current Y, X should be zero
+static void calib_sample(struct zip_pointer_2s_mixer_data *data, const enum p2sm_calib_phase phase) {
+    float r[2][2], y[2], len[2];
+    for (uint8_t s = 0; s < 2; s++) {
+        r[s][0] = (float) data->calib_raw[s][0];
+        r[s][1] = (float) data->calib_raw[s][1];
+        data->calib_raw[s][0] = 0;
+        data->calib_raw[s][1] = 0;
+
+        const float x = P2SM_COEF_TO_FLOAT(data->proj[s][0][0]) * r[s][0] + P2SM_COEF_TO_FLOAT(data->proj[s][0][1]) * r[s][1];
+        y[s] = P2SM_COEF_TO_FLOAT(data->proj[s][1][0]) * r[s][0] + P2SM_COEF_TO_FLOAT(data->proj[s][1][1]) * r[s][1];
+        len[s] = sqrtf(x * x + y[s] * y[s]);
+    }
+
+    // both sensors must see it, a count or two is mostly noise
+    if (len[0] < 2.0f || len[1] < 2.0f) {
+        return;
+    }
+
+    const float avg = (len[0] + len[1]) / 2;
+    for (uint8_t s = 0; s < 2; s++) {
+        float t[2] = { 0, 0 };
+        if (phase == P2SM_CALIB_ROLL_X) {
+            t[0] = avg;
+        } else if (phase == P2SM_CALIB_ROLL_Y) {
+            t[1] = avg;
+        } else {
+            t[1] = y[s] < 0 ? -len[s] : len[s];
+        }
+
+        struct p2sm_calib_acc *acc = &data->calib_acc[s];
+        acc->rxx += r[s][0] * r[s][0];
+        acc->rxy += r[s][0] * r[s][1];
+        acc->ryy += r[s][1] * r[s][1];
+        for (uint8_t i = 0; i < 2; i++) {
+            acc->b[i][0] += t[i] * r[s][0];
+            acc->b[i][1] += t[i] * r[s][1];
+        }
+        acc->tt += t[0] * t[0] + t[1] * t[1];
+    }
+    data->calib_samples[phase - P2SM_CALIB_ROLL_X]++;
+}
+
+// M = B A^-1, and the residual from the same sums:
+// sum |M r - t|^2 = tt - 2 sum(M .* B) + sum_i M_i A M_i^T
+static int calib_solve(struct zip_pointer_2s_mixer_data *data, struct p2sm_calib_result *out) {
+    if (data->calib_samples[0] < CONFIG_POINTER_2S_MIXER_CALIBRATION_MIN_SAMPLES ||
+        data->calib_samples[1] < CONFIG_POINTER_2S_MIXER_CALIBRATION_MIN_SAMPLES) {
+        return -EAGAIN;
+    }
+
+    for (uint8_t s = 0; s < 2; s++) {
+        const struct p2sm_calib_acc *acc = &data->calib_acc[s];
+        const float det = acc->rxx * acc->ryy - acc->rxy * acc->rxy;
+        // the raw counts of both rolls point (almost) the same way
+        if (det <= 1e-3f * acc->rxx * acc->ryy) {
+            return -EDOM;
+        }
+
+        const float inv[2][2] = { { acc->ryy / det, -acc->rxy / det }, { -acc->rxy / det, acc->rxx / det } };
+        float (*m)[2] = out->matrix[s];
+        float res = acc->tt;
+        for (uint8_t i = 0; i < 2; i++) {
+            m[i][0] = acc->b[i][0] * inv[0][0] + acc->b[i][1] * inv[1][0];
+            m[i][1] = acc->b[i][0] * inv[0][1] + acc->b[i][1] * inv[1][1];
+            res -= 2 * (m[i][0] * acc->b[i][0] + m[i][1] * acc->b[i][1]);
+            res += m[i][0] * m[i][0] * acc->rxx + 2 * m[i][0] * m[i][1] * acc->rxy + m[i][1] * m[i][1] * acc->ryy;
+        }
+        out->error[s] = sqrtf(MAX(res, 0.0f) / acc->tt);
+    }
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+// the ball turns at w = (wx, wy, wz) about its center. the projection is
+// built so that a roll shows up at both sensors as the motion of the ball
+// bottom, t = (-r wy, r wx), while a spin moves each contact point p along
+// the horizontal tangent (-py, px), which the rotation onto the bottom leaves
+// as is (it is that rotation's axis). so rotated_s = t + wz (-py_s, px_s):
+// four equations, three unknowns. the least-squares solution only depends on
+// the geometry, so just the 3x4 pseudo-inverse is kept, scaled to the
+// outputs: pointer = t, twist = wz times the sensors' distances from the
+// vertical axis, about what the heuristic's delta_y sees
+static bool rigid_build(struct zip_pointer_2s_mixer_data *data, const float p[2][3]) {
+    const float q[2][2] = { { -p[0][1], p[0][0] }, { -p[1][1], p[1][0] } };
+    const float d[2] = { q[0][0] - q[1][0], q[0][1] - q[1][1] };
+    const float dd = d[0] * d[0] + d[1] * d[1];
+    // same spot seen from above: a spin moves both sensors alike
+    if (dd < 1.0f) {
+        return false;
+    }
+
+    // wz = d . (r1 - r2) / |d|^2, t = (r1 + r2) / 2 - wz (q1 + q2) / 2
+    const float wz[4] = { d[0] / dd, d[1] / dd, -d[0] / dd, -d[1] / dd };
+    const float mid[2] = { (q[0][0] + q[1][0]) / 2, (q[0][1] + q[1][1]) / 2 };
+    const float spread = sqrtf(q[0][0] * q[0][0] + q[0][1] * q[0][1]) + sqrtf(q[1][0] * q[1][0] + q[1][1] * q[1][1]);
+    for (uint8_t k = 0; k < 4; k++) {
+        const uint8_t axis = k % 2;
+        data->rigid[0][k] = P2SM_FROM_FLOAT((axis == 0 ? 0.5f : 0.0f) - mid[0] * wz[k]);
+        data->rigid[1][k] = P2SM_FROM_FLOAT((axis == 1 ? 0.5f : 0.0f) - mid[1] * wz[k]);
+        data->rigid[2][k] = P2SM_FROM_FLOAT(spread * wz[k]);
     }
+    return true;
 }
 
-static int process_and_report(const struct device *dev) {
+// once per report, in place of the per-sensor motion: both sensors get the
+// bottom's, so gain, accel and smoothing see the same speeds as before
+static void rigid_solve(struct zip_pointer_2s_mixer_data *data) {
+    const p2sm_num_t r[4] = { data->rotated_x[0], data->rotated_y[0], data->rotated_x[1], data->rotated_y[1] };
+    p2sm_num_t out[3];
+    for (uint8_t o = 0; o < 3; o++) {
+        p2sm_sum_t acc = 0;
+        for (uint8_t k = 0; k < 4; k++) {
+            acc += P2SM_MUL(data->rigid[o][k], r[k]);
+        }
+        out[o] = num_sat(data, acc);
+    }
+
+    data->rotated_x[0] = data->rotated_x[1] = out[0];
+    data->rotated_y[0] = data->rotated_y[1] = out[1];
+    data->rigid_twist = num_sat_add(data, data->rigid_twist, out[2]);
+    data->rigid_motion = num_sat_add(data, data->rigid_motion,
+                                     (out[0] < 0 ? -out[0] : out[0]) + (out[1] < 0 ? -out[1] : out[1]));
+}
+
+static inline bool rigid_active(const struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params) {
+    if (params->twist_est != P2SM_TWIST_RIGID || !data->rigid_ok) {
+        return false;
+    }
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC) && IS_ENABLED(CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK)
+    // one sensor cannot tell a spin from a roll
+    if (data->single_sensor != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+#endif
+
+static int process_and_report(const struct device *dev, const struct p2sm_params *params, const uint32_t now) {
     struct zip_pointer_2s_mixer_data *data = dev->data;
-    const uint32_t now = (uint32_t) k_uptime_get();
-    uint32_t dt = now - data->last_rpt_time;
+    const uint32_t since_last = now - data->last_rpt_time;
+    uint32_t dt = since_last;
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+    const atomic_val_t calib_phase = atomic_get(&data->calib_phase);
+    if (unlikely(calib_collecting(calib_phase))) {
+        calib_sample(data, (enum p2sm_calib_phase) calib_phase);
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    const bool rigid = rigid_active(data, params);
+    if (rigid) {
+        rigid_solve(data);
+    }
+#else
+    const bool rigid = false;
+#endif
+
+    // the gain goes into the sensitivity, so the remainders keep what it
+    // leaves below a count
+    p2sm_num_t move_coef = params->move_coef;
+    if (params->accel_curve != P2SM_ACCEL_OFF) {
+        const p2sm_num_t gain = accel_gain(params, num_sat_add(data, data->rotated_x[0], data->rotated_x[1]),
+                                           num_sat_add(data, data->rotated_y[0], data->rotated_y[1]), since_last);
+        move_coef = P2SM_MUL(move_coef, gain);
+    }
 
     int16_t *twist_x[2] = { &data->twist_values.s1_x, &data->twist_values.s2_x };
     int16_t *twist_y[2] = { &data->twist_values.s1_y, &data->twist_values.s2_y };
     for (uint8_t s = 0; s < 2; s++) {
-        float rx = data->rotated_x[s];
-        float ry = data->rotated_y[s];
+        p2sm_num_t rx = data->rotated_x[s];
+        p2sm_num_t ry = data->rotated_y[s];
         if (rx == 0 && ry == 0) {
             continue;
         }
 
-        *twist_x[s] += (int16_t) rx;
-        *twist_y[s] += (int16_t) ry;
+        if (!rigid) {
+            *twist_x[s] = sat16(data, *twist_x[s] + num_to_int16(data, rx, P2SM_CLIP_TWIST), P2SM_CLIP_TWIST);
+            *twist_y[s] = sat16(data, *twist_y[s] + num_to_int16(data, ry, P2SM_CLIP_TWIST), P2SM_CLIP_TWIST);
+        }
 
-        apply_coef(data->move_coef, &rx, &ry);
-        if (dt > CONFIG_POINTER_2S_MIXER_REMAINDER_TTL) {
+        apply_coef(move_coef, &rx, &ry);
+        if (dt > P2SM_MS(CONFIG_POINTER_2S_MIXER_REMAINDER_TTL)) {
             data->rpt_x_remainder = rx;
             data->rpt_y_remainder = ry;
         } else {
-            data->rpt_x_remainder += rx;
-            data->rpt_y_remainder += ry;
+            data->rpt_x_remainder = num_sat_add(data, data->rpt_x_remainder, rx);
+            data->rpt_y_remainder = num_sat_add(data, data->rpt_y_remainder, ry);
         }
 
         data->rotated_x[s] = 0;
@@ -281,7 +1454,17 @@ static int process_and_report(const struct device *dev) {
         dt = 0;
     }
 
-    if (g_zrc_scroll_dis_ptr && now - data->last_rpt_time_twist < g_zrc_ptr_after_scroll) {
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+    // moving the pointer is not letting go of a twist either, whether the
+    // pointer is shown to move or not
+    const int32_t steady = (int32_t) params->steady_thres;
+    if (unlikely(data->kin_speed != 0) && (abs(P2SM_TO_INT(data->rpt_x_remainder)) > steady ||
+                                           abs(P2SM_TO_INT(data->rpt_y_remainder)) > steady)) {
+        kinetic_stop(data, now);
+    }
+#endif
+
+    if (params->scroll_dis_ptr && now - data->last_rpt_time_twist < P2SM_MS(params->ptr_after_scroll)) {
         data->last_rpt_time = now;
         data->rpt_x_remainder = 0;
         data->rpt_y_remainder = 0;
@@ -290,95 +1473,555 @@ static int process_and_report(const struct device *dev) {
         return 0;
     }
 
-    data->rpt_x = (int16_t) data->rpt_x_remainder;
-    data->rpt_y = (int16_t) data->rpt_y_remainder;
+    data->rpt_x = num_to_int16(data, data->rpt_x_remainder, P2SM_CLIP_REPORT);
+    data->rpt_y = num_to_int16(data, data->rpt_y_remainder, P2SM_CLIP_REPORT);
+
+    // motion held back for later, let out by settle_work once the pointer
+    // has not moved a whole count for the remainder TTL, a twist included
+    bool settle = false;
+    if (params->smooth_mode == P2SM_SMOOTH_SMA && (data->rpt_x || data->rpt_y)) {
+        apply_sma(data, params->sma_window_size, now, &data->rpt_x_remainder, &data->rpt_y_remainder);
+        data->rpt_x = num_to_int16(data, data->rpt_x_remainder, P2SM_CLIP_REPORT);
+        data->rpt_y = num_to_int16(data, data->rpt_y_remainder, P2SM_CLIP_REPORT);
+    } else if (params->smooth_mode == P2SM_SMOOTH_ONE_EURO) {
+        // runs on every report, sub-count ones included, to see the real rate
+        settle = apply_one_euro(data, params, since_last, &data->rpt_x_remainder, &data->rpt_y_remainder);
+        data->rpt_x = num_to_int16(data, data->rpt_x_remainder, P2SM_CLIP_REPORT);
+        data->rpt_y = num_to_int16(data, data->rpt_y_remainder, P2SM_CLIP_REPORT);
+    }
+
+    data->rpt_x_remainder -= P2SM_FROM_INT(data->rpt_x);
+    data->rpt_y_remainder -= P2SM_FROM_INT(data->rpt_y);
+
+    if (params->pred_enabled && params->pred_horizon > 0) {
+        settle |= apply_prediction(data, params, since_last, &data->rpt_x, &data->rpt_y);
+    }
+    if (settle) {
+        k_work_reschedule(&data->settle_work, K_MSEC(CONFIG_POINTER_2S_MIXER_REMAINDER_TTL));
+    }
+
+    const bool have_x = data->rpt_x != 0;
+    const bool have_y = data->rpt_y != 0;
+    if (have_x || have_y) {
+        const int32_t steady_thres = (int32_t) params->steady_thres;
+        if (abs(data->rpt_x) > steady_thres || abs(data->rpt_y) > steady_thres) {
+            data->last_sig_move = now;
+        }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+        pace_add(data, data->rpt_x, data->rpt_y, 0, 0, now);
+        data->rpt_x = 0;
+        data->rpt_y = 0;
+#else
+        if (have_x) {
+            input_report(dev, INPUT_EV_REL, INPUT_REL_X, data->rpt_x, !have_y, K_NO_WAIT);
+            P2SM_STAT_INC(data, reports_out);
+            data->rpt_x = 0;
+        }
+        if (have_y) {
+            input_report(dev, INPUT_EV_REL, INPUT_REL_Y, data->rpt_y, true, K_NO_WAIT);
+            P2SM_STAT_INC(data, reports_out);
+            data->rpt_y = 0;
+        }
+#endif
+    }
+
+    data->last_rpt_time = now;
+    return 0;
+}
+
+static void calculate_rotation_matrix(float from_x, float from_y, float from_z, float to_x, float to_y, float to_z, float matrix[3][3]) {
+    const float from_len = sqrtf(from_x*from_x + from_y*from_y + from_z*from_z);
+    from_x /= from_len;
+    from_y /= from_len;
+    from_z /= from_len;
+
+    const float to_len = sqrtf(to_x*to_x + to_y*to_y + to_z*to_z);
+    to_x /= to_len;
+    to_y /= to_len;
+    to_z /= to_len;
+
+    float axis_x = from_y * to_z - from_z * to_y;
+    float axis_y = from_z * to_x - from_x * to_z;
+    float axis_z = from_x * to_y - from_y * to_x;
+
+    const float axis_len = sqrtf(axis_x*axis_x + axis_y*axis_y + axis_z*axis_z);
+    if (axis_len < (float) 1e-6) {
+        LOG_ERR("Unexpected edge case. Consider repositioning one of the sensors.");
+        return;
+    }
+
+    axis_x /= axis_len;
+    axis_y /= axis_len;
+    axis_z /= axis_len;
+
+    const float cos_angle = from_x*to_x + from_y*to_y + from_z*to_z;
+    const float sin_angle = sqrtf(1.0f - cos_angle*cos_angle);
+
+    matrix[0][0] = cos_angle + axis_x*axis_x*(1-cos_angle);
+    matrix[0][1] = axis_x*axis_y*(1-cos_angle) - axis_z*sin_angle;
+    matrix[0][2] = axis_x*axis_z*(1-cos_angle) + axis_y*sin_angle;
+
+    matrix[1][0] = axis_y*axis_x*(1-cos_angle) + axis_z*sin_angle;
+    matrix[1][1] = cos_angle + axis_y*axis_y*(1-cos_angle);
+    matrix[1][2] = axis_y*axis_z*(1-cos_angle) - axis_x*sin_angle;
+
+    matrix[2][0] = axis_z*axis_x*(1-cos_angle) - axis_y*sin_angle;
+    matrix[2][1] = axis_z*axis_y*(1-cos_angle) + axis_x*sin_angle;
+    matrix[2][2] = cos_angle + axis_z*axis_z*(1-cos_angle);
+}
+
+// rotated_x/y[s] += proj[s] * (dx, dy). in fixed point a single full-scale
+// delta already overflows int32, so the products and the sum are taken wide
+// and rounded to Q16.16 once
+static void project_frame(struct zip_pointer_2s_mixer_data *data, const uint8_t s, const int32_t dx, const int32_t dy) {
+    const p2sm_coef_t (*m)[2] = data->proj[s];
+    const p2sm_sum_t x = (p2sm_sum_t) m[0][0] * dx + (p2sm_sum_t) m[0][1] * dy;
+    const p2sm_sum_t y = (p2sm_sum_t) m[1][0] * dx + (p2sm_sum_t) m[1][1] * dy;
+    data->rotated_x[s] = num_sat(data, (p2sm_sum_t) data->rotated_x[s] + P2SM_COEF_TO_NUM(x));
+    data->rotated_y[s] = num_sat(data, (p2sm_sum_t) data->rotated_y[s] + P2SM_COEF_TO_NUM(y));
+}
+
+// input thread, whenever a new params block shows up: folds the calibration
+// into the rotation so each frame is 4 MACs per sensor. integer only, the
+// float part was done by the writer in calib_build(). a fitted geometry
+// already includes what calibration would correct and is used as is
+static void proj_update(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params) {
+    const struct p2sm_calib_tbl *t = params->calib_tbl;
+    if (params->geom_fitted) {
+        memcpy(data->proj, t->geom, sizeof(data->proj));
+        data->proj_version = params->version;
+        return;
+    }
+
+    for (uint8_t s = 0; s < 2; s++) {
+        for (uint8_t i = 0; i < 2; i++) {
+            for (uint8_t j = 0; j < 2; j++) {
+                data->proj[s][i][j] = P2SM_COEF_MUL(data->rotation[s][i][0], t->calib[s][0][j]) +
+                                      P2SM_COEF_MUL(data->rotation[s][i][1], t->calib[s][1][j]);
+            }
+        }
+    }
+    data->proj_version = params->version;
+}
+
+static void apply_coef(const p2sm_num_t coef, p2sm_num_t *x, p2sm_num_t *y) {
+    *x = P2SM_MUL(*x, coef);
+    *y = P2SM_MUL(*y, coef);
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t r = 0, bit = (uint64_t) 1 << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t) r;
+}
+
+// once per HEALTH_WINDOW_MS, from whichever sensor ends the window: turns the
+// counters of the window into rates and flags and starts over. a sensor is
+// stalled when it sees motion in less than a quarter of the frames the other
+// one does, saturated when a delta hit the limit, noisy when it keeps moving
+// while the other one rests. the flags only pause twist: a stalled sensor
+// still reports some of the motion, the pointer keeps using it
+static void health_roll(struct zip_pointer_2s_mixer_data *data, const uint32_t now) {
+    const uint32_t window = now - data->health_window_start;
+    data->health_window_start = now;
+
+    for (uint8_t s = 0; s < 2; s++) {
+        struct p2sm_health_acc *acc = &data->health_acc[s];
+        const struct p2sm_health_acc *other = &data->health_acc[1 - s];
+        struct p2sm_health_sensor *out = &data->health.sensor[s];
+
+        out->flags = 0;
+        if (other->moving >= P2SM_HEALTH_MIN_FRAMES && acc->moving * 4 < other->moving) {
+            out->flags |= P2SM_HEALTH_STALL;
+        }
+        if (acc->saturations != out->saturations) {
+            out->flags |= P2SM_HEALTH_SATURATED;
+        }
+        if (acc->noise >= CONFIG_POINTER_2S_MIXER_HEALTH_NOISE_FRAMES) {
+            out->flags |= P2SM_HEALTH_NOISY;
+        }
+
+        out->rate_hz = (uint16_t) MIN((uint64_t) acc->frames * USEC_PER_SEC / MAX(window, 1), UINT16_MAX);
+        out->zero_run = acc->zero_run;
+        out->max_zero_run = MAX(acc->max_zero_run, acc->zero_run);
+        out->noise_frames = acc->noise;
+        out->saturations = acc->saturations;
+        memcpy(out->hist, acc->hist, sizeof(out->hist));
+    }
+
+    for (uint8_t s = 0; s < 2; s++) {
+        struct p2sm_health_acc *acc = &data->health_acc[s];
+        acc->frames = 0;
+        acc->moving = 0;
+        acc->noise = 0;
+        acc->max_zero_run = 0;
+        memset(acc->hist, 0, sizeof(acc->hist));
+    }
+
+    const uint32_t norm = isqrt64((uint64_t) data->health_xx) * isqrt64((uint64_t) data->health_yy);
+    data->health.correlation = norm > 0 ? (int8_t) CLAMP(data->health_xy * 100 / (int64_t) norm, -100, 100) : 0;
+    data->health_xy = 0;
+    data->health_xx = 0;
+    data->health_yy = 0;
+}
+
+// frame end, raw counts
+static void health_frame(struct zip_pointer_2s_mixer_data *data, const uint8_t s, const int32_t dx, const int32_t dy,
+                         const uint32_t now) {
+    struct p2sm_health_acc *acc = &data->health_acc[s];
+    const struct p2sm_health_acc *other = &data->health_acc[1 - s];
+    const uint32_t mag = (uint32_t) (abs(dx) + abs(dy));
+
+    acc->frames++;
+    acc->hist[MIN(mag == 0 ? 0 : 32 - __builtin_clz(mag), P2SM_HEALTH_HIST_BUCKETS - 1)]++;
+    if (mag == 0) {
+        acc->zero_run = (uint16_t) MIN(acc->zero_run + 1, UINT16_MAX);
+    } else {
+        acc->max_zero_run = MAX(acc->max_zero_run, acc->zero_run);
+        acc->zero_run = 0;
+    }
+
+    // up to NOISE_MAX it is not motion the other sensor has to see as well
+    if (mag > CONFIG_POINTER_2S_MIXER_HEALTH_NOISE_MAX) {
+        acc->moving++;
+    } else if (mag > 0) {
+        const bool other_rests = other->last_mag == 0 ||
+                                 now - other->last_frame > P2SM_MS(CONFIG_POINTER_2S_MIXER_SYNC_WINDOW_MS);
+        if (other_rests) {
+            acc->noise++;
+        }
+    }
+    acc->last_mag = (uint16_t) MIN(mag, UINT16_MAX);
+    acc->last_frame = now;
+
+    if (now - data->health_window_start >= P2SM_MS(CONFIG_POINTER_2S_MIXER_HEALTH_WINDOW_MS)) {
+        health_roll(data, now);
+    }
+}
+
+// right before a report consumes the projected motion of both sensors
+static inline void health_report(struct zip_pointer_2s_mixer_data *data) {
+    const int32_t x0 = P2SM_TO_INT(data->rotated_x[0]), y0 = P2SM_TO_INT(data->rotated_y[0]);
+    const int32_t x1 = P2SM_TO_INT(data->rotated_x[1]), y1 = P2SM_TO_INT(data->rotated_y[1]);
+    data->health_xy += (int64_t) x0 * x1 + (int64_t) y0 * y1;
+    data->health_xx += (int64_t) x0 * x0 + (int64_t) y0 * y0;
+    data->health_yy += (int64_t) x1 * x1 + (int64_t) y1 * y1;
+}
+
+static inline bool health_suppresses_twist(const struct zip_pointer_2s_mixer_data *data) {
+    return (data->health.sensor[0].flags | data->health.sensor[1].flags) != 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+// wz summed since the last evaluation. the solve already keeps rolls out of
+// it, so all that is left is a deadband and what an inexact geometry leaks
+static p2sm_num_t rigid_twist_eval(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params,
+                                   const uint32_t now) {
+    const p2sm_num_t twist = data->rigid_twist;
+    const p2sm_num_t motion = data->rigid_motion;
+    data->rigid_twist = 0;
+    data->rigid_motion = 0;
+    if (twist == 0) {
+        return 0;
+    }
+
+    P2SM_STAT_INC(data, twist_evals);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+    if (unlikely(health_suppresses_twist(data))) {
+        P2SM_STAT_DISCARD(data, P2SM_DISCARD_HEALTH);
+        return 0;
+    }
+#endif
+
+    const p2sm_num_t mag = twist < 0 ? -twist : twist;
+    if (mag < P2SM_FROM_INT(params->twist_thres)) {
+        P2SM_STAT_DISCARD(data, P2SM_DISCARD_TWIST_THRES);
+        return 0;
+    }
+    if ((p2sm_sum_t) mag * 100 < (p2sm_sum_t) motion * CONFIG_POINTER_2S_MIXER_RIGID_BODY_LEAK) {
+        P2SM_STAT_DISCARD(data, P2SM_DISCARD_SIGNIFICANT_TRANSLATION);
+        return 0;
+    }
+
+    data->last_twist = now;
+    if (params->feedback_en) {
+        k_work_reschedule(&data->twist_filter_cleanup_work, K_MSEC(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_TTL));
+    }
+    return twist;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+// quantile steps in 1/256 counts: up by q, down by 1 - q, so the estimate
+// settles where a fraction q of the samples is below it
+#define P2SM_ADAPT_UP   (128 * CONFIG_POINTER_2S_MIXER_ADAPTIVE_QUANTILE / 100)
+#define P2SM_ADAPT_DOWN MAX(1, 128 * (100 - CONFIG_POINTER_2S_MIXER_ADAPTIVE_QUANTILE) / 100)
+
+static inline void quantile_step(int32_t *est, const int32_t sample) {
+    const int32_t s = MIN(sample, INT16_MAX) * 256;
+    if (s > *est) {
+        *est += MIN(P2SM_ADAPT_UP, s - *est);
+    } else if (s < *est) {
+        *est -= MIN(P2SM_ADAPT_DOWN, *est - s);
+    }
+}
+
+// an eighth of the way per period, at least one count
+static bool adapt_slew(uint16_t *cur, const uint16_t configured, const int32_t target) {
+    const int32_t from = *cur != 0 ? *cur : configured;
+    if (target == from) {
+        return false;
+    }
+    const int32_t step = (target - from) / 8;
+    *cur = (uint16_t) (from + (step != 0 ? step : (target > from ? 1 : -1)));
+    return true;
+}
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+// an eighth away from what was saved; the estimates alone are not worth a write
+static inline bool adapt_drifted(const uint16_t cur, const uint16_t saved) {
+    return abs((int32_t) cur - saved) * 8 >= MAX(saved, 1);
+}
+#endif
+
+// adapt_lock held; returns whether the thresholds are worth saving again
+static bool adapt_update(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params,
+                         const uint16_t interference) {
+    struct p2sm_adaptive *a = &data->adapt;
+    if (a->noise_samples >= CONFIG_POINTER_2S_MIXER_ADAPTIVE_WARMUP) {
+        // twist_thres is per sensor, a twist moves each by half of delta_y
+        const int32_t learned = DIV_ROUND_UP(a->noise * CONFIG_POINTER_2S_MIXER_ADAPTIVE_MARGIN / 100, 2 * 256);
+        const int32_t target = CLAMP(learned, MAX(1, params->twist_thres * CONFIG_POINTER_2S_MIXER_ADAPTIVE_MIN / 100),
+                                     params->twist_thres * CONFIG_POINTER_2S_MIXER_ADAPTIVE_MAX / 100);
+        adapt_slew(&a->twist_thres, params->twist_thres, target);
+    }
+    if (interference != 0 && a->leak_samples >= CONFIG_POINTER_2S_MIXER_ADAPTIVE_WARMUP) {
+        const int32_t learned = DIV_ROUND_UP(a->leak * CONFIG_POINTER_2S_MIXER_ADAPTIVE_MARGIN / 100, 256);
+        const int32_t target = CLAMP(learned, MAX(1, interference * CONFIG_POINTER_2S_MIXER_ADAPTIVE_MIN / 100),
+                                     interference * CONFIG_POINTER_2S_MIXER_ADAPTIVE_MAX / 100);
+        adapt_slew(&a->interference, interference, target);
+    }
+#if IS_ENABLED(CONFIG_SETTINGS)
+    return adapt_drifted(a->twist_thres, data->adapt_saved[0]) || adapt_drifted(a->interference, data->adapt_saved[1]);
+#else
+    return false;
+#endif
+}
 
-    if (data->sma_enabled && (data->rpt_x || data->rpt_y)) {
-        apply_sma(data, &data->rpt_x_remainder, &data->rpt_y_remainder);
-        data->rpt_x = (int16_t) data->rpt_x_remainder;
-        data->rpt_y = (int16_t) data->rpt_y_remainder;
+// one sample per evaluated window, sorted by shape alone so the thresholds
+// being learned do not decide what they learn from; returns what is in effect
+static struct p2sm_adaptive adapt_learn(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params,
+                                        const uint16_t interference, const int32_t delta_y,
+                                        const int32_t translation, const uint32_t now) {
+    const k_spinlock_key_t key = k_spin_lock(&data->adapt_lock);
+    struct p2sm_adaptive *a = &data->adapt;
+    if (translation >= 2 * delta_y) {
+        quantile_step(&a->noise, delta_y);
+        a->noise_samples++;
+    } else if (delta_y >= 2 * translation) {
+        quantile_step(&a->leak, translation);
+        a->leak_samples++;
     }
 
-    data->rpt_x_remainder -= data->rpt_x;
-    data->rpt_y_remainder -= data->rpt_y;
-
-    const bool have_x = data->rpt_x != 0;
-    const bool have_y = data->rpt_y != 0;
-    if (have_x || have_y) {
-        const int32_t steady_thres = (int32_t) g_zrc_steady_thres;
-        if (abs(data->rpt_x) > steady_thres || abs(data->rpt_y) > steady_thres) {
-            data->last_sig_move = now;
-        }
-
-        if (have_x) {
-            input_report(dev, INPUT_EV_REL, INPUT_REL_X, data->rpt_x, !have_y, K_NO_WAIT);
-            data->rpt_x = 0;
-        }
-        if (have_y) {
-            input_report(dev, INPUT_EV_REL, INPUT_REL_Y, data->rpt_y, true, K_NO_WAIT);
-            data->rpt_y = 0;
-        }
+    bool drifted = false;
+    if (now - data->adapt_last >= P2SM_MS(CONFIG_POINTER_2S_MIXER_ADAPTIVE_PERIOD_MS)) {
+        data->adapt_last = now;
+        drifted = adapt_update(data, params, interference);
     }
+    const struct p2sm_adaptive snap = *a;
+    k_spin_unlock(&data->adapt_lock, key);
 
-    data->last_rpt_time = now;
-    return 0;
+#if IS_ENABLED(CONFIG_SETTINGS)
+    // a pending save is left alone, so this writes at most once per ADAPTIVE_SAVE_MIN
+    if (drifted) {
+        k_work_schedule(&data->adapt_save_work, K_MINUTES(CONFIG_POINTER_2S_MIXER_ADAPTIVE_SAVE_MIN));
+    }
+#else
+    ARG_UNUSED(drifted);
+#endif
+    return snap;
 }
+#endif
 
-static void calculate_rotation_matrix(float from_x, float from_y, float from_z, float to_x, float to_y, float to_z, float matrix[3][3]) {
-    const float from_len = sqrtf(from_x*from_x + from_y*from_y + from_z*from_z);
-    from_x /= from_len;
-    from_y /= from_len;
-    from_z /= from_len;
+// what one evaluated window amounts to for the state machine, from the first
+// gate that decides it, in the order the gates run; see twist_table
+enum twist_input {
+    TWIST_IN_WEAK, // under the threshold on either sensor
+    TWIST_IN_TRANSLATION, // this window moved both sensors the same way
+    TWIST_IN_REVERSE, // against the latched direction
+    TWIST_IN_INTERFERENCE, // the averages are mostly translation
+    TWIST_IN_FLAT, // no twist left in the averages
+    TWIST_IN_SHAPED, // a twist, debounce still running
+    TWIST_IN_STALE, // a twist, but none within twist_ttl before it
+    TWIST_IN_STEADY, // a twist, but the pointer moved within steady_cd
+    TWIST_IN_SETTLED, // a twist, through every gate
+    TWIST_IN_COUNT,
+};
 
-    const float to_len = sqrtf(to_x*to_x + to_y*to_y + to_z*to_z);
-    to_x /= to_len;
-    to_y /= to_len;
-    to_z /= to_len;
+#define TWIST_DO_TOUCH    BIT(0) // last_twist = now
+#define TWIST_DO_DEBOUNCE BIT(1) // debounce_start = now
+#define TWIST_DO_LATCH    BIT(2) // last_twist_direction = direction
+#define TWIST_DO_RESET    BIT(3) // reseed the averages
+#define TWIST_DO_EMIT     BIT(4)
 
-    float axis_x = from_y * to_z - from_z * to_y;
-    float axis_y = from_z * to_x - from_x * to_z;
-    float axis_z = from_x * to_y - from_y * to_x;
+#define TWIST_RESTART (TWIST_DO_TOUCH | TWIST_DO_DEBOUNCE)
+#define TWIST_NEW     (TWIST_RESTART | TWIST_DO_LATCH | TWIST_DO_RESET)
+#define TWIST_GO      (TWIST_DO_TOUCH | TWIST_DO_LATCH | TWIST_DO_EMIT)
 
-    const float axis_len = sqrtf(axis_x*axis_x + axis_y*axis_y + axis_z*axis_z);
-    if (axis_len < (float) 1e-6) {
-        LOG_ERR("Unexpected edge case. Consider repositioning one of the sensors.");
-        return;
-    }
+#define P2SM_DISCARD_NONE P2SM_DISCARD_COUNT
 
-    axis_x /= axis_len;
-    axis_y /= axis_len;
-    axis_z /= axis_len;
+struct twist_edge {
+    uint8_t next; // enum p2sm_twist_state
+    uint8_t actions; // TWIST_DO_*
+    uint8_t discard; // enum p2sm_twist_discard, counted when not NONE
+};
 
-    const float cos_angle = from_x*to_x + from_y*to_y + from_z*to_z;
-    const float sin_angle = sqrtf(1.0f - cos_angle*cos_angle);
+#define TE(next, actions, discard) { P2SM_TWIST_##next, actions, P2SM_DISCARD_##discard }
+
+// the scroll only starts from DEBOUNCING, after at least two twist windows
+// in a row: the one that started it and one that found the debounce over.
+// windows that move without twisting end a candidate and break the run,
+// while scrolling they are let through. weak windows are too small to tell
+// either way and keep the state
+static const struct twist_edge twist_table[P2SM_TWIST_STATE_COUNT][TWIST_IN_COUNT] = {
+    [P2SM_TWIST_IDLE] = {
+        [TWIST_IN_WEAK] = TE(IDLE, 0, TWIST_THRES),
+        [TWIST_IN_TRANSLATION] = TE(IDLE, 0, SIGNIFICANT_TRANSLATION),
+        [TWIST_IN_REVERSE] = TE(CANDIDATE, TWIST_NEW, DIRECTION_FILTER),
+        [TWIST_IN_INTERFERENCE] = TE(IDLE, TWIST_DO_RESET, INTERFERENCE),
+        [TWIST_IN_FLAT] = TE(IDLE, 0, NONE),
+        [TWIST_IN_SHAPED] = TE(CANDIDATE, TWIST_RESTART, DEBOUNCE),
+        [TWIST_IN_STALE] = TE(CANDIDATE, TWIST_RESTART, TIME_FILTER),
+        [TWIST_IN_STEADY] = TE(COOLDOWN, TWIST_RESTART, STEADY_COOLDOWN),
+        [TWIST_IN_SETTLED] = TE(CANDIDATE, TWIST_RESTART, DEBOUNCE),
+    },
+    [P2SM_TWIST_CANDIDATE] = {
+        [TWIST_IN_WEAK] = TE(CANDIDATE, 0, TWIST_THRES),
+        [TWIST_IN_TRANSLATION] = TE(IDLE, 0, SIGNIFICANT_TRANSLATION),
+        [TWIST_IN_REVERSE] = TE(CANDIDATE, TWIST_NEW, DIRECTION_FILTER),
+        [TWIST_IN_INTERFERENCE] = TE(IDLE, TWIST_DO_RESET, INTERFERENCE),
+        [TWIST_IN_FLAT] = TE(IDLE, 0, NONE),
+        [TWIST_IN_SHAPED] = TE(DEBOUNCING, TWIST_DO_TOUCH, DEBOUNCE),
+        [TWIST_IN_STALE] = TE(CANDIDATE, TWIST_RESTART, TIME_FILTER),
+        [TWIST_IN_STEADY] = TE(COOLDOWN, TWIST_RESTART, STEADY_COOLDOWN),
+        [TWIST_IN_SETTLED] = TE(DEBOUNCING, TWIST_DO_TOUCH, DEBOUNCE),
+    },
+    [P2SM_TWIST_DEBOUNCING] = {
+        [TWIST_IN_WEAK] = TE(DEBOUNCING, 0, TWIST_THRES),
+        [TWIST_IN_TRANSLATION] = TE(CANDIDATE, TWIST_DO_DEBOUNCE, SIGNIFICANT_TRANSLATION),
+        [TWIST_IN_REVERSE] = TE(CANDIDATE, TWIST_NEW, DIRECTION_FILTER),
+        [TWIST_IN_INTERFERENCE] = TE(CANDIDATE, TWIST_DO_DEBOUNCE | TWIST_DO_RESET, INTERFERENCE),
+        [TWIST_IN_FLAT] = TE(CANDIDATE, TWIST_DO_DEBOUNCE, NONE),
+        [TWIST_IN_SHAPED] = TE(DEBOUNCING, TWIST_DO_TOUCH, DEBOUNCE),
+        [TWIST_IN_STALE] = TE(CANDIDATE, TWIST_RESTART, TIME_FILTER),
+        [TWIST_IN_STEADY] = TE(COOLDOWN, TWIST_RESTART, STEADY_COOLDOWN),
+        [TWIST_IN_SETTLED] = TE(ACTIVE, TWIST_GO, NONE),
+    },
+    [P2SM_TWIST_ACTIVE] = {
+        [TWIST_IN_WEAK] = TE(ACTIVE, 0, TWIST_THRES),
+        [TWIST_IN_TRANSLATION] = TE(ACTIVE, 0, SIGNIFICANT_TRANSLATION),
+        [TWIST_IN_REVERSE] = TE(CANDIDATE, TWIST_NEW, DIRECTION_FILTER),
+        [TWIST_IN_INTERFERENCE] = TE(ACTIVE, TWIST_DO_RESET, INTERFERENCE),
+        [TWIST_IN_FLAT] = TE(ACTIVE, 0, NONE),
+        [TWIST_IN_SHAPED] = TE(DEBOUNCING, TWIST_DO_TOUCH, DEBOUNCE),
+        [TWIST_IN_STALE] = TE(CANDIDATE, TWIST_RESTART, TIME_FILTER),
+        [TWIST_IN_STEADY] = TE(COOLDOWN, TWIST_RESTART, STEADY_COOLDOWN),
+        [TWIST_IN_SETTLED] = TE(ACTIVE, TWIST_GO, NONE),
+    },
+    // each steady window pushes the debounce on; once the pointer has been
+    // still long enough the twist is debounced again before it scrolls
+    [P2SM_TWIST_COOLDOWN] = {
+        [TWIST_IN_WEAK] = TE(COOLDOWN, 0, TWIST_THRES),
+        [TWIST_IN_TRANSLATION] = TE(COOLDOWN, 0, SIGNIFICANT_TRANSLATION),
+        [TWIST_IN_REVERSE] = TE(CANDIDATE, TWIST_NEW, DIRECTION_FILTER),
+        [TWIST_IN_INTERFERENCE] = TE(COOLDOWN, TWIST_DO_RESET, INTERFERENCE),
+        [TWIST_IN_FLAT] = TE(COOLDOWN, 0, NONE),
+        [TWIST_IN_SHAPED] = TE(DEBOUNCING, TWIST_DO_TOUCH, DEBOUNCE),
+        [TWIST_IN_STALE] = TE(CANDIDATE, TWIST_RESTART, TIME_FILTER),
+        [TWIST_IN_STEADY] = TE(COOLDOWN, TWIST_RESTART, STEADY_COOLDOWN),
+        [TWIST_IN_SETTLED] = TE(DEBOUNCING, TWIST_DO_TOUCH, DEBOUNCE),
+    },
+};
 
-    matrix[0][0] = cos_angle + axis_x*axis_x*(1-cos_angle);
-    matrix[0][1] = axis_x*axis_y*(1-cos_angle) - axis_z*sin_angle;
-    matrix[0][2] = axis_x*axis_z*(1-cos_angle) + axis_y*sin_angle;
+#undef TE
 
-    matrix[1][0] = axis_y*axis_x*(1-cos_angle) + axis_z*sin_angle;
-    matrix[1][1] = cos_angle + axis_y*axis_y*(1-cos_angle);
-    matrix[1][2] = axis_y*axis_z*(1-cos_angle) - axis_x*sin_angle;
+static p2sm_num_t twist_step(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params,
+                             const enum twist_input in, const bool direction, const int result, const uint32_t now) {
+    const uint8_t from = data->twist_state;
+    const struct twist_edge *edge = &twist_table[from][in];
+    LOG_DBG("Twist window %d: state %d -> %d", in, from, edge->next);
 
-    matrix[2][0] = axis_z*axis_x*(1-cos_angle) - axis_y*sin_angle;
-    matrix[2][1] = axis_z*axis_y*(1-cos_angle) + axis_x*sin_angle;
-    matrix[2][2] = cos_angle + axis_z*axis_z*(1-cos_angle);
-}
+    if (edge->discard != P2SM_DISCARD_NONE) {
+        P2SM_STAT_DISCARD(data, edge->discard);
+    }
+    if (edge->actions & TWIST_DO_TOUCH) {
+        data->last_twist = now;
+    }
+    if (edge->actions & TWIST_DO_DEBOUNCE) {
+        data->debounce_start = now;
+    }
+    if (edge->actions & TWIST_DO_LATCH) {
+        data->last_twist_direction = direction;
+    }
+    if (edge->actions & TWIST_DO_RESET) {
+        data->ema_initialized = false;
+    }
+    if (edge->next != from) {
+        P2SM_STAT_TRANSITION(data, from, edge->next);
+        data->twist_state = edge->next;
+    }
+
+    if (!(edge->actions & TWIST_DO_EMIT)) {
+        return 0;
+    }
+    if (IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN) || params->feedback_en) {
+        k_work_reschedule(&data->twist_filter_cleanup_work, K_MSEC(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_TTL));
+    }
 
-static void apply_rotation(float matrix[3][3], const float dx, const float dy, float *out_x, float *out_y) {
-    *out_x = matrix[0][0] * dx + matrix[0][1] * dy;
-    *out_y = matrix[1][0] * dx + matrix[1][1] * dy;
+    LOG_DBG("Scroll value calculated: %d", result);
+    return P2SM_FROM_INT(result);
 }
 
-static void apply_coef(const float coef, float *x, float *y) {
-    *x *= coef;
-    *y *= coef;
+// twist_filter_cleanup_work ran out: the direction is forgotten and the
+// state goes back to IDLE, here so that only the mixing thread moves it
+static inline void twist_expire(struct zip_pointer_2s_mixer_data *data) {
+    if (likely(atomic_get(&data->twist_expired) == 0) || atomic_set(&data->twist_expired, 0) == 0) {
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN)
+    data->last_twist_direction = -1;
+#endif
+    if (data->twist_state != P2SM_TWIST_IDLE) {
+        P2SM_STAT_TRANSITION(data, data->twist_state, P2SM_TWIST_IDLE);
+        data->twist_state = P2SM_TWIST_IDLE;
+    }
+    LOG_DBG("Direction filter data discarded (timeout)");
 }
 
-static float calculate_twist(const struct device *dev) {
+static p2sm_num_t calculate_twist(const struct device *dev, const struct p2sm_params *params, const uint32_t now) {
     const struct zip_pointer_2s_mixer_config *config = dev->config;
     struct zip_pointer_2s_mixer_data *data = dev->data;
-    const uint32_t now = (uint32_t) k_uptime_get();
+    twist_expire(data);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    if (rigid_active(data, params)) {
+        return rigid_twist_eval(data, params, now);
+    }
+#endif
     const uint32_t passed = now - data->last_twist;
     const int16_t s1_x = data->twist_values.s1_x;
     const int16_t s1_y = data->twist_values.s1_y;
@@ -390,99 +2033,81 @@ static float calculate_twist(const struct device *dev) {
         return 0;
     }
 
-    const uint32_t filter_ttl = g_zrc_twist_ttl;
-    const bool hyst_en = g_zrc_twist_hyst_en;
-    const bool hyst_active = hyst_en && passed < filter_ttl;
-    const uint16_t eff_thres = hyst_active ? g_zrc_twist_hyst_thres : g_zrc_twist_thres;
-    const uint16_t eff_mul   = hyst_active ? g_zrc_twist_hyst_mul   : g_zrc_dy_mag_mul;
-    const uint16_t eff_div   = hyst_active ? g_zrc_twist_hyst_div   : g_zrc_dy_mag_div;
-
-    if (abs(s1_y) < eff_thres || abs(s2_y) < eff_thres) {
-        LOG_DBG("Discarded movement (reason = twist_thres)");
+    P2SM_STAT_INC(data, twist_evals);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+    if (unlikely(health_suppresses_twist(data))) {
+        LOG_DBG("Discarded movement (reason = health)");
+        P2SM_STAT_DISCARD(data, P2SM_DISCARD_HEALTH);
         return 0;
     }
+#endif
 
-    if (config->twist_interference_thres != 0) {
-        if (abs(s1_x+ s2_x) > config->twist_interference_thres || abs(s1_y + s2_y) > config->twist_interference_thres) {
-            LOG_DBG("Discarded movement (reason = significant_translation)");
-            return 0;
-        }
+    // sums of two int16, held at what Q16.16 can take
+    const int32_t dy_int = MIN(abs(s1_y - s2_y), INT16_MAX);
+    const int32_t translation_int = MIN(abs(s1_x + s2_x) + abs(s1_y + s2_y), INT16_MAX);
+
+    uint16_t thres = params->twist_thres, hyst_thres = params->twist_hyst_thres;
+    uint16_t interference = config->twist_interference_thres;
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+    const struct p2sm_adaptive adapt = adapt_learn(data, params, interference, dy_int, translation_int, now);
+    if (adapt.twist_thres != 0) {
+        hyst_thres = MAX(1, hyst_thres * adapt.twist_thres / thres);
+        thres = adapt.twist_thres;
+    }
+    if (interference != 0 && adapt.interference != 0) {
+        interference = adapt.interference;
     }
+#endif
 
+    const uint32_t filter_ttl = P2SM_MS(params->twist_ttl);
+    const bool hyst_active = params->twist_hyst_en && passed < filter_ttl;
+    const uint16_t eff_thres = hyst_active ? hyst_thres : thres;
+    const uint16_t eff_mul   = hyst_active ? params->twist_hyst_mul   : params->dy_mag_mul;
+    const uint16_t eff_div   = hyst_active ? params->twist_hyst_div   : params->dy_mag_div;
     const bool direction = s1_y < s2_y;
-#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN)
-    if (data->last_twist_direction != direction) {
-        data->last_twist_direction = direction;
-        data->last_twist = now;
-        data->debounce_start = now;
-        data->ema_initialized = false;
-        LOG_DBG("Discarded twist (reason = direction_filter)");
-        return 0;
+
+    if (abs(s1_y) < eff_thres || abs(s2_y) < eff_thres) {
+        return twist_step(data, params, TWIST_IN_WEAK, direction, 0, now);
+    }
+    if (interference != 0 && (abs(s1_x + s2_x) > interference || abs(s1_y + s2_y) > interference)) {
+        return twist_step(data, params, TWIST_IN_TRANSLATION, direction, 0, now);
+    }
+    if (IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN) && data->last_twist_direction != direction) {
+        return twist_step(data, params, TWIST_IN_REVERSE, direction, 0, now);
     }
-#endif
 
-    const float delta_y = (float) abs(direction ? s2_y - s1_y : s1_y - s2_y);
-    const float translation = abs(s1_x + s2_x) + abs(s1_y + s2_y);
+    const p2sm_num_t delta_y = P2SM_FROM_INT(dy_int);
+    const p2sm_num_t translation = P2SM_FROM_INT(translation_int);
     if (!data->ema_initialized) {
         data->ema_translation = translation;
         data->ema_delta_y = delta_y;
         data->ema_initialized = true;
     } else {
-        const float alpha = (float) g_zrc_ema_alpha / 100.0f;
-        data->ema_translation = alpha * translation + (1.0f - alpha) * data->ema_translation;
-        data->ema_delta_y = alpha * delta_y + (1.0f - alpha) * data->ema_delta_y;
-    }
-
-    const uint16_t avg_translation = (uint16_t) data->ema_translation;
-    const uint16_t avg_delta_y = (uint16_t) data->ema_delta_y;
-    const uint16_t max_mag = avg_translation * eff_mul / eff_div;
-    const float result = ((avg_delta_y - eff_thres) > max_mag ? avg_delta_y - avg_translation : 0) * (s1_y > s2_y ? -1 : 1);
-    const int int_result = abs((int) result);
-
-    if (config->twist_interference_thres != 0 && avg_translation > config->twist_interference_thres) {
-        LOG_DBG("Discarded twist (reason = significant_translation)");
-        data->ema_initialized = false;
-        return 0;
-    }
-
-    if (int_result == 0) {
-        return 0;
-    }
-
-    if (config->twist_interference_thres > 0 && avg_translation > config->twist_interference_thres) {
-        LOG_DBG("Discarded twist (reason = interference)");
-        return 0;
-    }
-
-    if (now - data->debounce_start < g_zrc_twist_deb) {
-        LOG_DBG("Discarded twist (reason = debounce)");
-        data->last_twist = now;
-        return 0;
-    }
-
-    if (passed > filter_ttl) {
-        LOG_DBG("Discarded twist (reason = time_filter)");
-        data->debounce_start = now;
-        data->last_twist = now;
-        return 0;
-    }
-
-    if (data->last_sig_move - now < g_zrc_steady_cd) {
-        LOG_DBG("Discarded twist (reason = steady_cooldown)");
-        data->debounce_start = now;
-        data->last_twist = now;
-        return 0;
+        const p2sm_num_t alpha = P2SM_DIV_INT(P2SM_FROM_INT(params->ema_alpha), 100);
+        data->ema_translation = P2SM_MUL(alpha, translation) + P2SM_MUL(P2SM_ONE - alpha, data->ema_translation);
+        data->ema_delta_y = P2SM_MUL(alpha, delta_y) + P2SM_MUL(P2SM_ONE - alpha, data->ema_delta_y);
     }
 
-    data->last_twist = now;
-    data->last_twist_direction = direction;
-
-    if (IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN) || g_zrc_feedback_en) {
-        k_work_reschedule(&data->twist_filter_cleanup_work, K_MSEC(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_TTL));
+    const uint16_t avg_translation = (uint16_t) P2SM_TO_INT(data->ema_translation);
+    const uint16_t avg_delta_y = (uint16_t) P2SM_TO_INT(data->ema_delta_y);
+    const int32_t max_mag = (int32_t) avg_translation * eff_mul / eff_div;
+    const int result = ((avg_delta_y - eff_thres) > max_mag ? avg_delta_y - avg_translation : 0) * (s1_y > s2_y ? -1 : 1);
+
+    enum twist_input in;
+    if (interference != 0 && avg_translation > interference) {
+        in = TWIST_IN_INTERFERENCE;
+    } else if (result == 0) {
+        in = TWIST_IN_FLAT;
+    } else if (now - data->debounce_start < P2SM_MS(params->twist_deb)) {
+        in = TWIST_IN_SHAPED;
+    } else if (passed > filter_ttl) {
+        in = TWIST_IN_STALE;
+    } else if (now - data->last_sig_move < P2SM_MS(params->steady_cd)) {
+        in = TWIST_IN_STEADY;
+    } else {
+        in = TWIST_IN_SETTLED;
     }
-
-    LOG_DBG("Scroll value calculated: %d", (int) result);
-    return result;
+    return twist_step(data, params, in, direction, result, now);
 }
 
 static void twist_filter_cleanup_work_cb(struct k_work *work) {
@@ -492,12 +2117,8 @@ static void twist_filter_cleanup_work_cb(struct k_work *work) {
     struct zip_pointer_2s_mixer_data *data = dev->data;
 
     data->twist_feedback_direction = -1;
-
-#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_DIRECTION_FILTER_EN)
-    data->last_twist_direction = -1;
-#endif
-
-    LOG_DBG("Direction filter data discarded (timeout)");
+    // see twist_expire()
+    atomic_set(&data->twist_expired, 1);
 }
 
 static int line_sphere_intersection(const float r, const float x, const float y, const float z, float intersection[3]);
@@ -520,22 +2141,33 @@ static int line_sphere_intersection(const float r, const float x, const float y,
 }
 
 static void on_sensor_event(struct zip_pointer_2s_mixer_data *data, const uint8_t s,
-                            struct input_event *event, const bool frame_end, const uint32_t now) {
+                            struct input_event *event, const bool frame_end, const uint32_t now, const bool batch) {
     int16_t *fx = (s == 0) ? &data->frame.s1_x : &data->frame.s2_x;
     int16_t *fy = (s == 0) ? &data->frame.s1_y : &data->frame.s2_y;
     bool *synced = (s == 0) ? &data->s1_synced : &data->s2_synced;
-    float (*matrix)[3] = (s == 0) ? data->rotation_matrix1 : data->rotation_matrix2;
 
 #if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC)
     uint32_t *last_report = (s == 0) ? &data->last_sensor1_report : &data->last_sensor2_report;
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK)
+    if (!(data->sensors_seen & BIT(s)) || now - *last_report > P2SM_MS(CONFIG_POINTER_2S_MIXER_SYNC_WINDOW_MS)) {
+        data->run_start[s] = now;
+        data->sensors_seen |= BIT(s);
+    }
+#endif
     *last_report = now;
 #endif
 
     if (event->code == INPUT_REL_X) {
-        *fx += event->value;
+        *fx = sat16(data, *fx + event->value, P2SM_CLIP_FRAME);
     } else if (event->code == INPUT_REL_Y) {
-        *fy += event->value;
+        *fy = sat16(data, *fy + event->value, P2SM_CLIP_FRAME);
+    }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+    if (unlikely(abs(event->value) >= CONFIG_POINTER_2S_MIXER_HEALTH_SATURATION)) {
+        data->health_acc[s].saturations++;
     }
+#endif
 
     if (!frame_end) {
         return;
@@ -546,88 +2178,278 @@ static void on_sensor_event(struct zip_pointer_2s_mixer_data *data, const uint8_
     *fx = 0;
     *fy = 0;
 
-    float rx, ry;
-    apply_rotation(matrix, (float) dx, (float) dy, &rx, &ry);
-    data->rotated_x[s] += rx;
-    data->rotated_y[s] += ry;
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+    health_frame(data, s, dx, dy, now);
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+    if (unlikely(calib_collecting(atomic_get(&data->calib_phase)))) {
+        data->calib_raw[s][0] += dx;
+        data->calib_raw[s][1] += dy;
+    }
+#endif
+
+    if (batch) {
+        data->batch_raw[s][0] += dx;
+        data->batch_raw[s][1] += dy;
+    } else {
+        project_frame(data, s, dx, dy);
+    }
     *synced = true;
 }
 
-static int sy_handle_event(const struct device *dev, struct input_event *event, const uint32_t p1,
-                           const uint32_t p2, struct zmk_input_processor_state *s) {
-    const struct zip_pointer_2s_mixer_config *config = dev->config;
+// once per event, or once per batch: params snapshot, lazy init, ZRC kick
+static const struct p2sm_params *mix_begin(const struct device *dev, const uint32_t now) {
     struct zip_pointer_2s_mixer_data *data = dev->data;
-    const uint32_t now = (uint32_t) k_uptime_get();
-    const bool frame_end = g_zrc_frame_sync ? event->sync : true;
+    const struct p2sm_params *params = params_acquire(data);
 
     if (unlikely(!data->initialized)) {
         if (!data_init(dev)) {
             LOG_ERR("Failed to initialize mixer driver data!");
-            return -1;
+            return NULL;
+        }
+    }
+
+    zrc_poll(data, now);
+    if (unlikely(params->version != data->proj_version)) {
+        proj_update(data, params);
+    }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+    if (unlikely(params->version != data->params_version)) {
+        data->params_version = params->version;
+        P2SM_STAT_INC(data, params_updates);
+    }
+#endif
+
+    return params;
+}
+
+// raw frame sums a batch has not projected yet, added to rotated_x/y right
+// before they are read
+static void batch_flush(struct zip_pointer_2s_mixer_data *data) {
+    for (uint8_t s = 0; s < 2; s++) {
+        if (data->batch_raw[s][0] == 0 && data->batch_raw[s][1] == 0) {
+            continue;
+        }
+
+        project_frame(data, s, data->batch_raw[s][0], data->batch_raw[s][1]);
+        data->batch_raw[s][0] = 0;
+        data->batch_raw[s][1] = 0;
+    }
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC) && IS_ENABLED(CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK)
+// the sensor that has said nothing while the other kept reporting for longer
+// than the sync window, -1 if there is none. a sensor that never reported
+// (boot, reconnect) is not silent, and neither is one that paused together
+// with the other: the first motion after a rest is no desync
+static int8_t silent_sensor(const struct zip_pointer_2s_mixer_data *data) {
+    const uint32_t last[2] = { data->last_sensor1_report, data->last_sensor2_report };
+    if (data->sensors_seen != (BIT(0) | BIT(1))) {
+        return -1;
+    }
+
+    for (uint8_t s = 0; s < 2; s++) {
+        const uint8_t other = 1 - s;
+        // the other one's reports since it started its run or since this
+        // one last spoke, whichever is later
+        const uint32_t from = (int32_t) (data->run_start[other] - last[s]) > 0 ? data->run_start[other] : last[s];
+        if ((int32_t) (last[other] - from) > (int32_t) P2SM_MS(CONFIG_POINTER_2S_MIXER_SYNC_WINDOW_MS)) {
+            return (int8_t) s;
         }
     }
+    return -1;
+}
+
+// one sensor has been silent for longer than the sync window (lifted off,
+// dropped frames): keep the pointer going on the other one instead of
+// dropping everything. its motion is mirrored into the silent sensor's slot,
+// so the gain, accel speed and smoothing downstream stay the same as with two
+// sensors and nothing jumps when the second one comes back. the copy
+// replaces whatever the silent slot holds, it is never added to it. no twist,
+// it needs both
+static int mix_single(const struct device *dev, const struct p2sm_params *params, const uint8_t alive,
+                      const uint32_t now, const bool batch) {
+    const struct zip_pointer_2s_mixer_config *config = dev->config;
+    struct zip_pointer_2s_mixer_data *data = dev->data;
+    const uint8_t silent = 1 - alive;
+    bool *alive_synced = alive == 0 ? &data->s1_synced : &data->s2_synced;
+
+    const uint8_t mode = alive == 0 ? INPUT_MIXER_SENSOR1 : INPUT_MIXER_SENSOR2;
+    if (data->single_sensor != mode) {
+        // whatever the silent sensor left half-way is stale by now
+        if (silent == 0) {
+            data->frame.s1_x = 0;
+            data->frame.s1_y = 0;
+            data->s1_synced = false;
+        } else {
+            data->frame.s2_x = 0;
+            data->frame.s2_y = 0;
+            data->s2_synced = false;
+        }
+        data->rotated_x[silent] = 0;
+        data->rotated_y[silent] = 0;
+        data->batch_raw[silent][0] = 0;
+        data->batch_raw[silent][1] = 0;
+        data->single_sensor = mode;
+        P2SM_STAT_INC(data, single_sensor_entries);
+    }
+
+    if (*alive_synced && now - data->last_rpt_time >= config->sync_report_us) {
+        *alive_synced = false;
+        data->batch_raw[silent][0] = 0;
+        data->batch_raw[silent][1] = 0;
+        if (batch) {
+            batch_flush(data);
+        }
+        data->rotated_x[silent] = data->rotated_x[alive];
+        data->rotated_y[silent] = data->rotated_y[alive];
+        process_and_report(dev, params, now);
+    }
+    return 0;
+}
+#endif
+
+// one event into the frame; in a batch the projection is deferred to
+// batch_flush()
+static void mix_add(struct zip_pointer_2s_mixer_data *data, const struct p2sm_params *params,
+                    struct input_event *event, const uint32_t p1, const uint32_t now, const bool batch) {
+    const bool frame_end = params->frame_sync ? event->sync : true;
 
-    zrc_cache_refresh_if_due(now);
+    P2SM_STAT_INC(data, events_in);
+    if (frame_end) {
+        P2SM_STAT_INC(data, frames_in);
+    }
 
     if (p1 & INPUT_MIXER_SENSOR1) {
-        on_sensor_event(data, 0, event, frame_end, now);
+        on_sensor_event(data, 0, event, frame_end, now, batch);
     } else if (p1 & INPUT_MIXER_SENSOR2) {
-        on_sensor_event(data, 1, event, frame_end, now);
+        on_sensor_event(data, 1, event, frame_end, now, batch);
+    }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+    if (unlikely(data->kin_coasting) && event->value != 0) {
+        kinetic_stop(data, now);
     }
+#endif
 
     event->value = 0;
     event->sync = false;
+}
+
+// sync gate, report and twist: after every event, or once per batch on the
+// time of its last event
+static int mix_emit(const struct device *dev, const struct p2sm_params *params, const uint32_t now,
+                    const bool batch) {
+    const struct zip_pointer_2s_mixer_config *config = dev->config;
+    struct zip_pointer_2s_mixer_data *data = dev->data;
 
 #if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ENSURE_SYNC)
-    if (unlikely(abs((int32_t) (data->last_sensor1_report - data->last_sensor2_report)) > CONFIG_POINTER_2S_MIXER_SYNC_WINDOW_MS)) {
+    const int32_t sync_skew = (int32_t) (data->last_sensor1_report - data->last_sensor2_report);
+    bool desync = abs(sync_skew) > P2SM_MS(CONFIG_POINTER_2S_MIXER_SYNC_WINDOW_MS);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_SINGLE_SENSOR_FALLBACK)
+    const int8_t silent = silent_sensor(data);
+    if (unlikely(silent >= 0)) {
+        return mix_single(dev, params, (uint8_t) (1 - silent), now, batch);
+    }
+    if (unlikely(data->single_sensor)) {
+        // what was collected for twist had one sensor mirrored
+        data->single_sensor = 0;
+        memset(&data->twist_values, 0, sizeof(data->twist_values));
+        P2SM_STAT_INC(data, dual_resyncs);
+    }
+    // until both have reported there is nothing to fall back from, one
+    // sensor alone is dropped as without the fallback
+    desync = desync && data->sensors_seen != (BIT(0) | BIT(1));
+#endif
+    if (unlikely(desync)) {
         memset(&data->frame, 0, sizeof(struct p2sm_dataframe));
         memset(&data->twist_values, 0, sizeof(struct p2sm_dataframe));
         memset(data->rotated_x, 0, sizeof(data->rotated_x));
         memset(data->rotated_y, 0, sizeof(data->rotated_y));
+        memset(data->batch_raw, 0, sizeof(data->batch_raw));
         data->s1_synced = false;
         data->s2_synced = false;
+        P2SM_STAT_INC(data, sync_resets);
         return 0;
     }
 #endif
 
-    if (data->s1_synced && data->s2_synced && now - data->last_rpt_time > config->sync_report_ms) {
+    if (data->s1_synced && data->s2_synced && now - data->last_rpt_time >= config->sync_report_us) {
         data->s1_synced = false;
         data->s2_synced = false;
-        process_and_report(dev);
+        if (batch) {
+            batch_flush(data);
+        }
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+        health_report(data);
+#endif
+        process_and_report(dev, params, now);
     }
 
-    const bool global_enabled = g_zrc_twist_global_en;
-    if (data->twist_enabled && global_enabled && now - data->last_rpt_time_twist > config->sync_scroll_report_ms) {
-        const float twist_float = calculate_twist(dev) * data->twist_coef;
-        if (now - data->last_twist > CONFIG_POINTER_2S_MIXER_TWIST_REMAINDER_TTL) {
-            data->rpt_twist_remainder = twist_float;
+    if (params->twist_enabled && params->twist_global_en && now - data->last_rpt_time_twist >= config->sync_scroll_report_us) {
+        const p2sm_num_t twist_val = P2SM_MUL(calculate_twist(dev, params, now), params->twist_coef);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+        kinetic_track(data, params->twist_reversed ? -twist_val : twist_val, now);
+#endif
+        const bool twist_stale = now - data->last_twist > P2SM_MS(CONFIG_POINTER_2S_MIXER_TWIST_REMAINDER_TTL);
+        if (twist_stale) {
+            data->rpt_twist_remainder = twist_val;
         } else {
-            data->rpt_twist_remainder += twist_float;
+            data->rpt_twist_remainder = num_sat_add(data, data->rpt_twist_remainder, twist_val);
+        }
+
+        // without notch output, still counted for the feedback
+        const int16_t twist_int = num_to_int16(data, data->rpt_twist_remainder, P2SM_CLIP_REPORT);
+
+#if P2SM_SCROLL_HI_RES
+        // the fraction the notches wait on goes out right away
+        const p2sm_num_t twist_hr = num_sat(data, (p2sm_sum_t) twist_val * P2SM_HI_RES_PER_NOTCH);
+        data->rpt_twist_hr_remainder = twist_stale ? twist_hr : num_sat_add(data, data->rpt_twist_hr_remainder, twist_hr);
+        const int16_t twist_hr_int = num_to_int16(data, data->rpt_twist_hr_remainder, P2SM_CLIP_REPORT);
+        if (twist_hr_int != 0) {
+            data->last_rpt_time_twist = now;
+            data->rpt_twist_hr_remainder -= P2SM_FROM_INT(twist_hr_int);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+            pace_add(data, 0, 0, 0, params->twist_reversed ? -twist_hr_int : twist_hr_int, now);
+#else
+            input_report(dev, INPUT_EV_REL, INPUT_REL_WHEEL_HI_RES, params->twist_reversed ? -twist_hr_int : twist_hr_int,
+                         !P2SM_SCROLL_NOTCHES || twist_int == 0, K_NO_WAIT);
+            P2SM_STAT_INC(data, wheel_hi_res_reports_out);
+#endif
         }
+#endif
 
-        const int16_t twist_int = (int16_t) data->rpt_twist_remainder;
         if (twist_int != 0) {
             data->last_rpt_time_twist = now;
-            data->rpt_twist_remainder -= twist_int;
-            input_report(dev, INPUT_EV_REL, INPUT_REL_WHEEL, data->twist_reversed ? -twist_int : twist_int, true, K_NO_WAIT);
+            data->rpt_twist_remainder -= P2SM_FROM_INT(twist_int);
+#if P2SM_SCROLL_NOTCHES
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+            pace_add(data, 0, 0, params->twist_reversed ? -twist_int : twist_int, 0, now);
+#else
+            input_report(dev, INPUT_EV_REL, INPUT_REL_WHEEL, params->twist_reversed ? -twist_int : twist_int, true, K_NO_WAIT);
+            P2SM_STAT_INC(data, wheel_reports_out);
+#endif
+#endif
 
-            if (g_zrc_feedback_en) {
+            if (params->feedback_en) {
                 data->twist_accumulator += abs(twist_int);
 
-                const bool direction = twist_float > 0;
-                const uint16_t fb_thres = g_zrc_fb_thres;
+                const bool direction = twist_val > 0;
+                const uint16_t fb_thres = params->fb_thres;
                 if (config->feedback_gpios.port != NULL &&
                     (data->twist_accumulator >= fb_thres || data->twist_feedback_direction != direction) &&
                     fb_thres > 0) {
                     data->twist_accumulator = 0;
 
-                    if (data->feedback_is_in_cooldown && now < data->feedback_cooldown_until) {
-                        LOG_DBG("Twist feedback skipped (in cooldown until %d)", data->feedback_cooldown_until - now);
+                    if (data->feedback_is_in_cooldown && (int32_t) (data->feedback_cooldown_until - now) > 0) {
+                        LOG_DBG("Twist feedback skipped (in cooldown for %d ms)", (data->feedback_cooldown_until - now) / USEC_PER_MSEC);
                         data->twist_feedback_direction = direction;
                         return 0;
                     }
 
-                    if (data->feedback_start_time > 0 && (now - data->feedback_start_time) >= g_zrc_fb_max_cont) {
+                    if (data->feedback_start_time > 0 && (now - data->feedback_start_time) >= P2SM_MS(params->fb_max_cont)) {
                         k_work_cancel_delayable(&data->twist_feedback_off_work);
                         k_work_cancel_delayable(&data->twist_feedback_extra_delay_work);
 
@@ -638,10 +2460,10 @@ static int sy_handle_event(const struct device *dev, struct input_event *event,
 
                         data->feedback_start_time = 0;
                         data->feedback_is_in_cooldown = true;
-                        data->feedback_cooldown_until = now + g_zrc_fb_cooldown;
-                        k_work_reschedule(&data->twist_feedback_cooldown_work, K_MSEC(g_zrc_fb_cooldown));
+                        data->feedback_cooldown_until = now + P2SM_MS(params->fb_cooldown);
+                        k_work_reschedule(&data->twist_feedback_cooldown_work, K_MSEC(params->fb_cooldown));
 
-                        LOG_DBG("Twist feedback forced off after max continuous duration, cooldown for %d ms", g_zrc_fb_cooldown);
+                        LOG_DBG("Twist feedback forced off after max continuous duration, cooldown for %d ms", params->fb_cooldown);
                         data->twist_feedback_direction = direction;
                         return 0;
                     }
@@ -665,12 +2487,174 @@ static int sy_handle_event(const struct device *dev, struct input_event *event,
         }
     }
 
-    return 0;
+    return 0;
+}
+
+static int mix_event(const struct device *dev, struct input_event *event, const uint32_t p1, const uint32_t now) {
+    const struct p2sm_params *params = mix_begin(dev, now);
+    if (!params) {
+        return -1;
+    }
+    mix_add(dev->data, params, event, p1, now, false);
+    return mix_emit(dev, params, now, false);
+}
+
+// a run of events in one pass: params and ZRC are settled once, each
+// sensor's frames are summed raw and projected once, and the sync gate, the
+// report and the twist window run once on the last event's time. one report
+// for the whole run, the same one per-event processing sends when the run
+// falls inside one report window
+static int mix_batch(const struct device *dev, const struct p2sm_event *events, const size_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const struct p2sm_params *params = mix_begin(dev, events[count - 1].t_us);
+    if (!params) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        struct input_event event = {
+            .type = INPUT_EV_REL,
+            .code = events[i].code,
+            .value = events[i].value,
+            .sync = (events[i].flags & P2SM_EVENT_SYNC) != 0,
+        };
+        mix_add(dev->data, params, &event, events[i].flags & (INPUT_MIXER_SENSOR1 | INPUT_MIXER_SENSOR2),
+                events[i].t_us, true);
+    }
+    const int ret = mix_emit(dev, params, events[count - 1].t_us, true);
+    batch_flush(dev->data);
+    return ret;
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+static K_THREAD_STACK_DEFINE(p2sm_queue_stack, CONFIG_POINTER_2S_MIXER_QUEUE_STACK_SIZE);
+static struct k_work_q p2sm_queue_wq;
+
+// producer side, the input thread: one slot write and one atomic store
+static void queue_push(struct zip_pointer_2s_mixer_data *data, const struct input_event *event, const uint32_t p1,
+                       const uint32_t now) {
+    const uint32_t head = (uint32_t) atomic_get(&data->queue_head);
+    const uint32_t used = head - (uint32_t) atomic_get(&data->queue_tail);
+    if (unlikely(used >= CONFIG_POINTER_2S_MIXER_QUEUE_SIZE)) {
+        data->queue_dropped++;
+        return;
+    }
+
+    struct p2sm_event *rec = &data->queue_buf[head & (CONFIG_POINTER_2S_MIXER_QUEUE_SIZE - 1)];
+    rec->t_us = now;
+    rec->value = (int16_t) CLAMP(event->value, INT16_MIN, INT16_MAX);
+    rec->code = (uint8_t) event->code;
+    rec->flags = (uint8_t) (p1 & (INPUT_MIXER_SENSOR1 | INPUT_MIXER_SENSOR2)) | (event->sync ? P2SM_EVENT_SYNC : 0);
+    atomic_set(&data->queue_head, (atomic_val_t) (head + 1));
+
+    if (used + 1 > data->queue_hwm) {
+        data->queue_hwm = (uint16_t) (used + 1);
+    }
+    k_work_submit_to_queue(&p2sm_queue_wq, &data->queue_work);
+}
+
+// consumer side, the mixer thread: takes everything pushed so far as one
+// batch (two if it wraps), frees the slots and looks again
+static void queue_work_cb(struct k_work *work) {
+    struct zip_pointer_2s_mixer_data *data = CONTAINER_OF(work, struct zip_pointer_2s_mixer_data, queue_work);
+    uint32_t tail = (uint32_t) atomic_get(&data->queue_tail);
+    for (;;) {
+        const uint32_t head = (uint32_t) atomic_get(&data->queue_head);
+        if (head == tail) {
+            break;
+        }
+
+        while (tail != head) {
+            const uint32_t idx = tail & (CONFIG_POINTER_2S_MIXER_QUEUE_SIZE - 1);
+            const uint32_t n = MIN(head - tail, CONFIG_POINTER_2S_MIXER_QUEUE_SIZE - idx);
+            mix_batch(data->dev, &data->queue_buf[idx], n);
+            tail += n;
+        }
+        atomic_set(&data->queue_tail, (atomic_val_t) tail);
+        data->queue_batches++;
+    }
+}
+#endif
+
+static int handle_event(const struct device *dev, struct input_event *event, const uint32_t p1,
+                        const uint32_t p2, struct zmk_input_processor_state *s) {
+    struct zip_pointer_2s_mixer_data *data = dev->data;
+    const uint32_t now = p2sm_now_us();
+    data->input_thread = k_current_get();
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+    if (unlikely(data->capture_active)) {
+        capture_event(data, event, p1, now);
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+    queue_push(data, event, p1, now);
+    event->value = 0;
+    event->sync = false;
+    return 0;
+#else
+    return mix_event(dev, event, p1, now);
+#endif
+}
+
+static int sy_handle_event(const struct device *dev, struct input_event *event, const uint32_t p1,
+                           const uint32_t p2, struct zmk_input_processor_state *s) {
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+    struct zip_pointer_2s_mixer_data *data = dev->data;
+    const uint32_t start = k_cycle_get_32();
+    const int ret = handle_event(dev, event, p1, p2, s);
+    const uint32_t cycles = k_cycle_get_32() - start;
+
+    // bucket i holds [2^i, 2^(i+1)) cycles, the last one everything above
+    const uint8_t bucket = MIN(31 - __builtin_clz(cycles | 1), P2SM_STATS_HIST_BUCKETS - 1);
+    data->stats.cycles_hist[bucket]++;
+    data->stats.cycles_total += cycles;
+    if (cycles > data->stats.cycles_max) {
+        data->stats.cycles_max = cycles;
+    }
+    return ret;
+#else
+    return handle_event(dev, event, p1, p2, s);
+#endif
 }
 
 static int sy_init(const struct device *dev) {
     struct zip_pointer_2s_mixer_data *data = dev->data;
     data->dev = dev;
+    params_init(data);
+#if IS_ENABLED(CONFIG_ZMK_RUNTIME_CONFIG)
+    // first event kicks the first read
+    data->zrc_last_kick = (uint32_t) -P2SM_MS(CONFIG_POINTER_2S_MIXER_ZRC_POLL_MS);
+#endif
+#if IS_ENABLED(CONFIG_SETTINGS)
+    k_work_init_delayable(&data->save_work, p2sm_save_work_cb);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+    k_work_init_delayable(&data->adapt_save_work, adapt_save_work_cb);
+#endif
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+    k_work_init_delayable(&data->pace_work, pace_work_cb);
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)
+    k_work_init_delayable(&data->kinetic_work, kinetic_work_cb);
+#endif
+    k_work_init_delayable(&data->settle_work, settle_work_cb);
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+    // one mixer thread for all instances
+    static bool queue_started;
+    if (!queue_started) {
+        const struct k_work_queue_config cfg = { .name = "p2sm" };
+        k_work_queue_init(&p2sm_queue_wq);
+        k_work_queue_start(&p2sm_queue_wq, p2sm_queue_stack, K_THREAD_STACK_SIZEOF(p2sm_queue_stack),
+                           CONFIG_POINTER_2S_MIXER_QUEUE_PRIORITY, &cfg);
+        queue_started = true;
+    }
+    k_work_init(&data->queue_work, queue_work_cb);
+#endif
 
 #if !IS_ENABLED(CONFIG_POINTER_2S_MIXER_LAZY_INIT)
     if (!data_init(dev)) {
@@ -683,11 +2667,6 @@ static int sy_init(const struct device *dev) {
 }
 
 static int data_init(const struct device *dev) {
-    if (g_dev != NULL) {
-        LOG_ERR("Only one mixer instance is supported at the moment");
-        return 0;
-    }
-
     const struct zip_pointer_2s_mixer_config *config = dev->config;
     struct zip_pointer_2s_mixer_data *data = dev->data;
     const float radius = config->ball_radius;
@@ -713,31 +2692,44 @@ static int data_init(const struct device *dev) {
         return 0;
     }
 
-    calculate_rotation_matrix(surface_p1[0], surface_p1[1], surface_p1[2], 0, 0, -radius, data->rotation_matrix1);
-    calculate_rotation_matrix(surface_p2[0], surface_p2[1], surface_p2[2], 0, 0, -radius, data->rotation_matrix2);
+    float matrix1[3][3] = {0}, matrix2[3][3] = {0};
+    calculate_rotation_matrix(surface_p1[0], surface_p1[1], surface_p1[2], 0, 0, -radius, matrix1);
+    calculate_rotation_matrix(surface_p2[0], surface_p2[1], surface_p2[2], 0, 0, -radius, matrix2);
+    for (uint8_t i = 0; i < 2; i++) {
+        for (uint8_t j = 0; j < 2; j++) {
+            data->rotation[0][i][j] = P2SM_COEF_FROM_FLOAT(matrix1[i][j]);
+            data->rotation[1][i][j] = P2SM_COEF_FROM_FLOAT(matrix2[i][j]);
+        }
+    }
+    // the lock keeps the current block and its tables from being recycled
+    k_mutex_lock(&data->params_lock, K_FOREVER);
+    proj_update(data, atomic_ptr_get(&data->params));
+    k_mutex_unlock(&data->params_lock);
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    const float surface[2][3] = {
+        { surface_p1[0], surface_p1[1], surface_p1[2] },
+        { surface_p2[0], surface_p2[1], surface_p2[2] },
+    };
+    data->rigid_ok = rigid_build(data, surface);
+    if (!data->rigid_ok) {
+        LOG_WRN("Sensor positions cannot resolve the ball's rotation, rigid-body estimator disabled");
+    }
+#endif
 
     data->last_twist_direction = -1;
-    data->move_coef = (float) CONFIG_POINTER_2S_MIXER_DEFAULT_MOVE_COEF / 100;
-    data->twist_coef = (float) CONFIG_POINTER_2S_MIXER_DEFAULT_TWIST_COEF / 100;
-    data->twist_enabled = true;
+    data->twist_state = P2SM_TWIST_IDLE;
 
-    data->ema_delta_y = 0.0f;
-    data->ema_translation = 0.0f;
+    data->ema_delta_y = 0;
+    data->ema_translation = 0;
     data->ema_initialized = false;
 
-    data->sma_enabled = false;
-    data->sma_buffer = NULL;
     data->sma_window_size = CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE;
     data->sma_head_index = 0;
     data->sma_count = 0;
+    memset(data->sma_sum, 0, sizeof(data->sma_sum));
 
-    // going >1 means losing precision
-    // acceptable for scroll but not movement
-    if (data->move_coef > 1.0f) {
-        data->move_coef = 1.0f;
-    }
-
-    LOG_DBG("Sensor mixer driver initialized");
+    LOG_DBG("Sensor mixer driver initialized (instance %d)", config->inst);
     LOG_DBG("  > Ball radius: %d", (int) config->ball_radius);
     LOG_DBG("  > Surface trackpoint 1 ≈ (%d, %d, %d)", (int) surface_p1[0], (int) surface_p1[1], (int) surface_p1[2]);
     LOG_DBG("  > Surface trackpoint 2 ≈ (%d, %d, %d)", (int) surface_p2[0], (int) surface_p2[1], (int) surface_p2[2]);
@@ -769,14 +2761,14 @@ static int data_init(const struct device *dev) {
     data->feedback_is_in_cooldown = false;
     k_work_init_delayable(&data->twist_feedback_cooldown_work, twist_feedback_cooldown_work_cb);
 
-    g_dev = (struct device *) dev;
     data->initialized = true;
 
-    p2sm_sens_driver_init();
-
-#if IS_ENABLED(CONFIG_SETTINGS)
-    k_work_init_delayable(&p2sm_save_work, p2sm_save_work_cb);
-#endif
+    // shared by all instances
+    static bool sens_initialized = false;
+    if (!sens_initialized) {
+        sens_initialized = true;
+        p2sm_sens_driver_init();
+    }
 
     k_work_init_delayable(&data->twist_filter_cleanup_work, twist_filter_cleanup_work_cb);
     return 1;
@@ -801,10 +2793,11 @@ static void twist_feedback_extra_delay_work_cb(struct k_work *work) {
     struct zip_pointer_2s_mixer_data *data = CONTAINER_OF(dwork, struct zip_pointer_2s_mixer_data, twist_feedback_extra_delay_work);
     const struct device *dev = data->dev;
     const struct zip_pointer_2s_mixer_config *config = dev->config;
-    const uint32_t now = (uint32_t) k_uptime_get();
-    const uint32_t elapsed = data->feedback_start_time > 0 ? now - data->feedback_start_time : 0;
-    const uint32_t remaining_duration = g_zrc_fb_max_cont > elapsed ? g_zrc_fb_max_cont - elapsed : 0;
-    const uint32_t feedback_duration = g_zrc_fb_dur < remaining_duration ? g_zrc_fb_dur : remaining_duration;
+    const struct p2sm_params params = params_read(data);
+    const uint32_t now = p2sm_now_us();
+    const uint32_t elapsed = data->feedback_start_time > 0 ? (now - data->feedback_start_time) / USEC_PER_MSEC : 0;
+    const uint32_t remaining_duration = params.fb_max_cont > elapsed ? params.fb_max_cont - elapsed : 0;
+    const uint32_t feedback_duration = params.fb_dur < remaining_duration ? params.fb_dur : remaining_duration;
 
     if (feedback_duration > 0) {
         gpio_pin_set_dt(&config->feedback_gpios, 1);
@@ -816,9 +2809,9 @@ static void twist_feedback_extra_delay_work_cb(struct k_work *work) {
         gpio_pin_set_dt(&config->feedback_gpios, 0);
         data->feedback_start_time = 0;
         data->feedback_is_in_cooldown = true;
-        data->feedback_cooldown_until = now + g_zrc_fb_cooldown;
-        k_work_reschedule(&data->twist_feedback_cooldown_work, K_MSEC(g_zrc_fb_cooldown));
-        LOG_DBG("Twist feedback after delay immediately off, max duration reached, cooldown for %d ms", g_zrc_fb_cooldown);
+        data->feedback_cooldown_until = now + P2SM_MS(params.fb_cooldown);
+        k_work_reschedule(&data->twist_feedback_cooldown_work, K_MSEC(params.fb_cooldown));
+        LOG_DBG("Twist feedback after delay immediately off, max duration reached, cooldown for %d ms", params.fb_cooldown);
     }
 }
 
@@ -836,9 +2829,15 @@ static struct zmk_input_processor_driver_api sy_driver_api = {
 };
 
 #if IS_ENABLED(CONFIG_SETTINGS)
-static void p2sm_save_one(const char *suffix, const void *value, const size_t len) {
+// instance 0 keeps the keys it had before multi-instance support
+static void p2sm_save_one(const uint8_t inst, const char *suffix, const void *value, const size_t len) {
     char key[36];
-    snprintf(key, sizeof(key), "%s/%s", P2SM_SETTINGS_PREFIX, suffix);
+    if (inst == 0) {
+        snprintf(key, sizeof(key), "%s/%s", P2SM_SETTINGS_PREFIX, suffix);
+    } else {
+        snprintf(key, sizeof(key), "%s/%d/%s", P2SM_SETTINGS_PREFIX, inst, suffix);
+    }
+
     const int err = settings_save_one(key, value, len);
     if (err < 0) {
         LOG_ERR("Failed to save settings %d", err);
@@ -846,121 +2845,665 @@ static void p2sm_save_one(const char *suffix, const void *value, const size_t le
 }
 
 static void p2sm_save_work_cb(struct k_work *work) {
-    const struct zip_pointer_2s_mixer_data *data = g_dev->data;
-    const float values[2] = { data->move_coef, data->twist_coef };
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct zip_pointer_2s_mixer_data *data = CONTAINER_OF(dwork, struct zip_pointer_2s_mixer_data, save_work);
+    const struct zip_pointer_2s_mixer_config *config = data->dev->config;
+    const uint8_t inst = config->inst;
+
+    // holding the lock keeps the block and its tables from being recycled while we copy them
+    k_mutex_lock(&data->params_lock, K_FOREVER);
+    const struct p2sm_params params = *(const struct p2sm_params *) atomic_ptr_get(&data->params);
+    const struct p2sm_accel_tbl accel = *params.accel_tbl;
+    const struct p2sm_calib_tbl cal = *params.calib_tbl;
+    k_mutex_unlock(&data->params_lock);
+
+    const float values[2] = { P2SM_TO_FLOAT(params.move_coef), P2SM_TO_FLOAT(params.twist_coef) };
+    p2sm_save_one(inst, "global", values, sizeof(values));
+    p2sm_save_one(inst, "twist_reversed", &params.twist_reversed, sizeof(params.twist_reversed));
+    // sma_en is still written for older firmware; "smooth" supersedes it
+    const bool sma_en = params.smooth_mode == P2SM_SMOOTH_SMA;
+    p2sm_save_one(inst, "sma_en", &sma_en, sizeof(sma_en));
+    p2sm_save_one(inst, "smooth", &params.smooth_mode, sizeof(params.smooth_mode));
+    p2sm_save_one(inst, "sma_win", &params.sma_window_size, sizeof(params.sma_window_size));
+    p2sm_save_one(inst, "pred_en", &params.pred_enabled, sizeof(params.pred_enabled));
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    p2sm_save_one(inst, "twist_est", &params.twist_est, sizeof(params.twist_est));
+#endif
+
+    // only what differs from devicetree is kept, so a new curve there still
+    // applies after a reflash; zero length deletes the key
+    struct p2sm_accel_point dt_pts[P2SM_ACCEL_MAX_POINTS];
+    accel_points_from_config(config, dt_pts);
+    const bool dt_curve = params.accel_curve == config->accel_curve;
+    const bool dt_points = params.accel_npoints == config->accel_npoints &&
+        memcmp(accel.points, dt_pts, sizeof(dt_pts)) == 0;
+    p2sm_save_one(inst, "accel", &params.accel_curve, dt_curve ? 0 : sizeof(params.accel_curve));
+    p2sm_save_one(inst, "accel_pts", accel.points, dt_points ? 0 : params.accel_npoints * sizeof(accel.points[0]));
+
+    float geom[2][2][2];
+    for (uint8_t s = 0; s < 2; s++) {
+        for (uint8_t i = 0; i < 2; i++) {
+            for (uint8_t j = 0; j < 2; j++) {
+                geom[s][i][j] = P2SM_COEF_TO_FLOAT(cal.geom[s][i][j]);
+            }
+        }
+    }
+    p2sm_save_one(inst, "geom", geom, params.geom_fitted ? sizeof(geom) : 0);
+}
 
-    p2sm_save_one("global", values, sizeof(values));
-    p2sm_save_one("twist_reversed", &data->twist_reversed, sizeof(data->twist_reversed));
-    p2sm_save_one("sma_en", &data->sma_enabled, sizeof(data->sma_enabled));
-    p2sm_save_one("sma_win", &data->sma_window_size, sizeof(data->sma_window_size));
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+// "adapt" is a version byte, then the fields of struct p2sm_adaptive in
+// order, little endian. A layout change bumps the version; a value of
+// another version or size is dropped and the thresholds are learned again.
+#define P2SM_ADAPT_BLOB_VERSION 1
+#define P2SM_ADAPT_BLOB_SIZE    (1 + 4 * sizeof(uint32_t) + 2 * sizeof(uint16_t))
+
+static void adapt_pack(const struct p2sm_adaptive *a, uint8_t blob[P2SM_ADAPT_BLOB_SIZE]) {
+    blob[0] = P2SM_ADAPT_BLOB_VERSION;
+    sys_put_le32((uint32_t) a->noise, &blob[1]);
+    sys_put_le32((uint32_t) a->leak, &blob[5]);
+    sys_put_le32(a->noise_samples, &blob[9]);
+    sys_put_le32(a->leak_samples, &blob[13]);
+    sys_put_le16(a->twist_thres, &blob[17]);
+    sys_put_le16(a->interference, &blob[19]);
 }
 
-static void p2sm_save_config() {
-    k_work_reschedule(&p2sm_save_work, K_MSEC(CONFIG_POINTER_2S_MIXER_SETTINGS_SAVE_DELAY));
+static bool adapt_unpack(const uint8_t blob[P2SM_ADAPT_BLOB_SIZE], struct p2sm_adaptive *a) {
+    if (blob[0] != P2SM_ADAPT_BLOB_VERSION) {
+        return false;
+    }
+    a->noise = (int32_t) sys_get_le32(&blob[1]);
+    a->leak = (int32_t) sys_get_le32(&blob[5]);
+    a->noise_samples = sys_get_le32(&blob[9]);
+    a->leak_samples = sys_get_le32(&blob[13]);
+    a->twist_thres = sys_get_le16(&blob[17]);
+    a->interference = sys_get_le16(&blob[19]);
+    return true;
+}
+
+// only "adapt": armed by adapt_learn() once the thresholds drift, and by a reset
+static void adapt_save_work_cb(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct zip_pointer_2s_mixer_data *data = CONTAINER_OF(dwork, struct zip_pointer_2s_mixer_data, adapt_save_work);
+    const struct zip_pointer_2s_mixer_config *config = data->dev->config;
+
+    const k_spinlock_key_t key = k_spin_lock(&data->adapt_lock);
+    const struct p2sm_adaptive adapt = data->adapt;
+    data->adapt_saved[0] = adapt.twist_thres;
+    data->adapt_saved[1] = adapt.interference;
+    k_spin_unlock(&data->adapt_lock, key);
+
+    uint8_t blob[P2SM_ADAPT_BLOB_SIZE];
+    adapt_pack(&adapt, blob);
+    const bool learned = adapt.noise_samples != 0 || adapt.leak_samples != 0;
+    p2sm_save_one(config->inst, "adapt", blob, learned ? sizeof(blob) : 0);
 }
 #endif
+#endif
+
+static __attribute__((noinline)) struct zip_pointer_2s_mixer_data *p2sm_data(const uint8_t inst) {
+    if (inst >= P2SM_NUM_INST) {
+        LOG_ERR("No mixer instance %d", inst);
+        return NULL;
+    }
 
-static __attribute__((noinline)) struct zip_pointer_2s_mixer_data *p2sm_data(void) {
-    if (g_dev == NULL) {
+    struct zip_pointer_2s_mixer_data *data = g_instances[inst];
+    if (!data->initialized) {
         LOG_ERR("Device not initialized!");
         return NULL;
     }
-    return g_dev->data;
+    return data;
 }
 
-#if IS_ENABLED(CONFIG_SETTINGS)
-#define P2SM_PERSIST() p2sm_save_config()
-#else
-#define P2SM_PERSIST() ((void)0)
+uint8_t p2sm_num_instances() {
+    return P2SM_NUM_INST;
+}
+
+float p2sm_get_move_coef(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? P2SM_TO_FLOAT(params_read(data).move_coef) : 0;
+}
+
+float p2sm_get_twist_coef(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? P2SM_TO_FLOAT(params_read(data).twist_coef) : 0;
+}
+
+void p2sm_set_move_coef(const uint8_t inst, const float coef) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    struct p2sm_params *next = params_begin(data);
+    next->move_coef = P2SM_FROM_FLOAT(coef);
+    params_publish(data, next);
+    P2SM_PERSIST(data);
+}
+
+void p2sm_set_twist_coef(const uint8_t inst, const float coef) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    struct p2sm_params *next = params_begin(data);
+    next->twist_coef = P2SM_FROM_FLOAT(coef);
+    params_publish(data, next);
+    P2SM_PERSIST(data);
+}
+
+bool p2sm_twist_enabled(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? params_read(data).twist_enabled : false;
+}
+
+bool p2sm_twist_is_reversed(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? params_read(data).twist_reversed : false;
+}
+
+static void p2sm_toggle_twist_set_reversed(struct zip_pointer_2s_mixer_data *data, const bool reversed) {
+    struct p2sm_params *next = params_begin(data);
+    next->twist_reversed = reversed;
+    params_publish(data, next);
+}
+
+void p2sm_toggle_twist_reverse(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    struct p2sm_params *next = params_begin(data);
+    next->twist_reversed = !next->twist_reversed;
+    params_publish(data, next);
+    P2SM_PERSIST(data);
+}
+
+void p2sm_toggle_twist(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    struct p2sm_params *next = params_begin(data);
+    next->twist_enabled = !next->twist_enabled;
+    params_publish(data, next);
+}
+
+bool p2sm_sma_enabled(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? params_read(data).smooth_mode == P2SM_SMOOTH_SMA : false;
+}
+
+// disabling SMA leaves any other smoothing mode alone, so that the legacy
+// sma_en key loads correctly before or after "smooth"
+static void p2sm_set_sma_enabled_nosave(struct zip_pointer_2s_mixer_data *data, const bool enabled) {
+    struct p2sm_params *next = params_begin(data);
+    if (enabled) {
+        next->smooth_mode = P2SM_SMOOTH_SMA;
+    } else if (next->smooth_mode == P2SM_SMOOTH_SMA) {
+        next->smooth_mode = P2SM_SMOOTH_OFF;
+    }
+    params_publish(data, next);
+}
+
+void p2sm_set_sma_enabled(const uint8_t inst, const bool enabled) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    p2sm_set_sma_enabled_nosave(data, enabled);
+    P2SM_PERSIST(data);
+}
+
+uint8_t p2sm_get_sma_window(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? params_read(data).sma_window_size : 0;
+}
+
+// the input thread rebuilds the SMA sum when it sees a different window
+static void p2sm_set_sma_window_nosave(struct zip_pointer_2s_mixer_data *data, const uint8_t window_size) {
+    struct p2sm_params *next = params_begin(data);
+    next->sma_window_size = MIN(window_size, CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX);
+    params_publish(data, next);
+}
+
+void p2sm_set_sma_window(const uint8_t inst, const uint8_t window_size) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    p2sm_set_sma_window_nosave(data, window_size);
+    P2SM_PERSIST(data);
+}
+
+enum p2sm_smooth_mode p2sm_get_smooth_mode(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? (enum p2sm_smooth_mode) params_read(data).smooth_mode : P2SM_SMOOTH_OFF;
+}
+
+static void p2sm_set_smooth_mode_nosave(struct zip_pointer_2s_mixer_data *data, const enum p2sm_smooth_mode mode) {
+    if (mode >= P2SM_SMOOTH_COUNT) {
+        return;
+    }
+    struct p2sm_params *next = params_begin(data);
+    next->smooth_mode = mode;
+    params_publish(data, next);
+}
+
+void p2sm_set_smooth_mode(const uint8_t inst, const enum p2sm_smooth_mode mode) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    p2sm_set_smooth_mode_nosave(data, mode);
+    P2SM_PERSIST(data);
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+enum p2sm_twist_estimator p2sm_get_twist_estimator(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? (enum p2sm_twist_estimator) params_read(data).twist_est : P2SM_TWIST_HEURISTIC;
+}
+
+static void p2sm_set_twist_estimator_nosave(struct zip_pointer_2s_mixer_data *data, const enum p2sm_twist_estimator est) {
+    if (est >= P2SM_TWIST_COUNT) {
+        return;
+    }
+    struct p2sm_params *next = params_begin(data);
+    next->twist_est = est;
+    params_publish(data, next);
+}
+
+void p2sm_set_twist_estimator(const uint8_t inst, const enum p2sm_twist_estimator est) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    p2sm_set_twist_estimator_nosave(data, est);
+    P2SM_PERSIST(data);
+}
 #endif
 
-float p2sm_get_move_coef() {
-    const struct zip_pointer_2s_mixer_data *data = p2sm_data();
-    return data ? data->move_coef : 0;
+bool p2sm_one_euro_get_config(const uint8_t inst, struct p2sm_one_euro_config *out) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+    const struct p2sm_params params = params_read(data);
+    out->min_cutoff = params.oe_min_cut;
+    out->beta = params.oe_beta;
+    out->d_cutoff = params.oe_d_cut;
+    return true;
+}
+
+bool p2sm_predict_enabled(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? params_read(data).pred_enabled : false;
+}
+
+static void p2sm_set_predict_enabled_nosave(struct zip_pointer_2s_mixer_data *data, const bool enabled) {
+    struct p2sm_params *next = params_begin(data);
+    next->pred_enabled = enabled;
+    params_publish(data, next);
+}
+
+void p2sm_set_predict_enabled(const uint8_t inst, const bool enabled) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    p2sm_set_predict_enabled_nosave(data, enabled);
+    P2SM_PERSIST(data);
+}
+
+bool p2sm_predict_get_config(const uint8_t inst, struct p2sm_predict_config *out) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+    const struct p2sm_params params = params_read(data);
+    out->horizon_us = params.pred_horizon;
+    out->alpha = params.pred_alpha;
+    out->max_lead = params.pred_max;
+    return true;
+}
+
+enum p2sm_accel_curve p2sm_get_accel_curve(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? (enum p2sm_accel_curve) params_read(data).accel_curve : P2SM_ACCEL_OFF;
+}
+
+static void p2sm_set_accel_curve_nosave(struct zip_pointer_2s_mixer_data *data, const enum p2sm_accel_curve curve) {
+    if (curve >= P2SM_ACCEL_COUNT) {
+        return;
+    }
+    struct p2sm_params *next = params_begin(data);
+    next->accel_curve = curve;
+    accel_build(next, params_accel(data, next));
+    params_publish(data, next);
+}
+
+void p2sm_set_accel_curve(const uint8_t inst, const enum p2sm_accel_curve curve) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    p2sm_set_accel_curve_nosave(data, curve);
+    P2SM_PERSIST(data);
+}
+
+static int p2sm_set_accel_points_nosave(struct zip_pointer_2s_mixer_data *data, const struct p2sm_accel_point *points,
+                                        const uint8_t num_points) {
+    if (num_points > P2SM_ACCEL_MAX_POINTS) {
+        return -EINVAL;
+    }
+    for (uint8_t i = 1; i < num_points; i++) {
+        if (points[i].speed <= points[i - 1].speed) {
+            return -EINVAL;
+        }
+    }
+
+    struct p2sm_params *next = params_begin(data);
+    struct p2sm_accel_tbl *t = params_accel(data, next);
+    memset(t->points, 0, sizeof(t->points));
+    memcpy(t->points, points, num_points * sizeof(*points));
+    next->accel_npoints = num_points;
+    accel_build(next, t);
+    params_publish(data, next);
+    return 0;
+}
+
+int p2sm_set_accel_points(const uint8_t inst, const struct p2sm_accel_point *points, const uint8_t num_points) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return -ENODEV;
+    const int err = p2sm_set_accel_points_nosave(data, points, num_points);
+    if (err == 0) {
+        P2SM_PERSIST(data);
+    }
+    return err;
+}
+
+bool p2sm_accel_get_config(const uint8_t inst, struct p2sm_accel_config *out) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+
+    k_mutex_lock(&data->params_lock, K_FOREVER);
+    const struct p2sm_params *params = atomic_ptr_get(&data->params);
+    out->curve = (enum p2sm_accel_curve) params->accel_curve;
+    out->top = params->accel_top;
+    out->sigmoid_gain = params->accel_gain;
+    out->sigmoid_mid = params->accel_mid;
+    out->sigmoid_width = params->accel_width;
+    out->num_points = params->accel_npoints;
+    memcpy(out->points, params->accel_tbl->points, sizeof(out->points));
+    k_mutex_unlock(&data->params_lock);
+    return true;
+}
+
+uint16_t p2sm_accel_gain_at(const uint8_t inst, const uint16_t speed) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return 0;
+
+    // one ms worth of motion at that speed, through the same lookup
+    k_mutex_lock(&data->params_lock, K_FOREVER);
+    const struct p2sm_params *params = atomic_ptr_get(&data->params);
+    const p2sm_num_t gain = params->accel_curve == P2SM_ACCEL_OFF ? P2SM_ONE :
+        accel_gain(params, P2SM_DIV_INT(P2SM_FROM_INT(speed), 10), 0, USEC_PER_MSEC);
+    k_mutex_unlock(&data->params_lock);
+    return (uint16_t) lroundf(P2SM_TO_FLOAT(gain) * 100.0f);
+}
+
+static void p2sm_set_geometry_nosave(struct zip_pointer_2s_mixer_data *data, const float (*m)[2][2]) {
+    struct p2sm_params *next = params_begin(data);
+    struct p2sm_calib_tbl *t = params_calib(data, next);
+    next->geom_fitted = m != NULL;
+    for (uint8_t s = 0; s < 2; s++) {
+        for (uint8_t i = 0; i < 2; i++) {
+            for (uint8_t j = 0; j < 2; j++) {
+                t->geom[s][i][j] = m ? P2SM_COEF_FROM_FLOAT(m[s][i][j]) : 0;
+            }
+        }
+    }
+    params_publish(data, next);
+}
+
+void p2sm_geometry_reset(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    p2sm_set_geometry_nosave(data, NULL);
+    P2SM_PERSIST(data);
+}
+
+bool p2sm_geometry_is_fitted(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? params_read(data).geom_fitted : false;
 }
 
-float p2sm_get_twist_coef() {
-    const struct zip_pointer_2s_mixer_data *data = p2sm_data();
-    return data ? data->twist_coef : 0;
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+// the input thread only touches the sums while collecting, so they are
+// reset with the phase parked at IDLE
+void p2sm_calib_start(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    atomic_set(&data->calib_phase, P2SM_CALIB_IDLE);
+    memset(data->calib_raw, 0, sizeof(data->calib_raw));
+    memset(data->calib_acc, 0, sizeof(data->calib_acc));
+    memset(data->calib_samples, 0, sizeof(data->calib_samples));
+    data->calib_solved = false;
+    atomic_set(&data->calib_phase, P2SM_CALIB_ROLL_X);
 }
 
-void p2sm_set_move_coef(const float coef) {
-    struct zip_pointer_2s_mixer_data *data = p2sm_data();
+void p2sm_calib_next(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
     if (!data) return;
-    data->move_coef = coef;
-    P2SM_PERSIST();
+    const atomic_val_t phase = atomic_get(&data->calib_phase);
+    if (calib_collecting(phase)) {
+        atomic_set(&data->calib_phase, phase + 1);
+    }
 }
 
-void p2sm_set_twist_coef(const float coef) {
-    struct zip_pointer_2s_mixer_data *data = p2sm_data();
+void p2sm_calib_abort(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
     if (!data) return;
-    data->twist_coef = coef;
-    P2SM_PERSIST();
+    atomic_set(&data->calib_phase, P2SM_CALIB_IDLE);
+    data->calib_solved = false;
 }
 
-bool p2sm_twist_enabled() {
-    const struct zip_pointer_2s_mixer_data *data = p2sm_data();
-    return data ? data->twist_enabled : false;
+bool p2sm_calib_get_status(const uint8_t inst, struct p2sm_calib_status *out) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+    out->phase = (enum p2sm_calib_phase) atomic_get(&data->calib_phase);
+    memcpy(out->samples, data->calib_samples, sizeof(out->samples));
+    return true;
 }
 
-bool p2sm_twist_is_reversed() {
-    const struct zip_pointer_2s_mixer_data *data = p2sm_data();
-    return data ? data->twist_reversed : false;
+int p2sm_calib_solve(const uint8_t inst, struct p2sm_calib_result *out) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return -ENODEV;
+    if (atomic_get(&data->calib_phase) != P2SM_CALIB_DONE) {
+        return -EBUSY;
+    }
+
+    const int err = calib_solve(data, &data->calib_result);
+    data->calib_solved = err == 0;
+    if (err == 0 && out != NULL) {
+        *out = data->calib_result;
+    }
+    return err;
+}
+
+int p2sm_calib_apply(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return -ENODEV;
+    if (!data->calib_solved) {
+        return -EAGAIN;
+    }
+
+    p2sm_set_geometry_nosave(data, data->calib_result.matrix);
+    P2SM_PERSIST(data);
+    atomic_set(&data->calib_phase, P2SM_CALIB_IDLE);
+    data->calib_solved = false;
+    return 0;
 }
+#endif
 
-void p2sm_toggle_twist_reverse() {
-    struct zip_pointer_2s_mixer_data *data = p2sm_data();
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_REPORT_PACING)
+void p2sm_report_flush(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
     if (!data) return;
-    data->twist_reversed = !data->twist_reversed;
-    P2SM_PERSIST();
+    k_work_cancel_delayable(&data->pace_work);
+    pace_flush(data);
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+bool p2sm_stats_get(const uint8_t inst, struct p2sm_stats *out) {
+    const struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+    *out = data->stats;
+    return true;
 }
 
-static void p2sm_toggle_twist_set_reversed(const bool reversed) {
-    struct zip_pointer_2s_mixer_data *data = p2sm_data();
+void p2sm_stats_reset(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
     if (!data) return;
-    data->twist_reversed = reversed;
+    memset(&data->stats, 0, sizeof(data->stats));
+}
+#endif
+
+uint32_t p2sm_timestamp() {
+    return p2sm_now_us();
+}
+
+int p2sm_mix_batch(const uint8_t inst, const struct p2sm_event *events, const size_t count) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return -ENODEV;
+
+    // a batch enters where single events do, on the input thread: the mixer
+    // state has no lock, and with the queue the ring has one producer
+    const k_tid_t tid = k_current_get();
+    const bool own = data->input_thread == NULL || data->input_thread == tid;
+    __ASSERT(own, "p2sm_mix_batch() called off the input thread");
+    if (!own) return -EPERM;
+    data->input_thread = tid;
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+    for (size_t i = 0; i < count; i++) {
+        const struct input_event event = {
+            .type = INPUT_EV_REL,
+            .code = events[i].code,
+            .value = events[i].value,
+            .sync = (events[i].flags & P2SM_EVENT_SYNC) != 0,
+        };
+        queue_push(data, &event, events[i].flags, events[i].t_us);
+    }
+    return 0;
+#else
+    return mix_batch(data->dev, events, count);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+// written by the input thread once per window, a torn read is possible
+bool p2sm_health_get(const uint8_t inst, struct p2sm_health *out) {
+    const struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+    *out = data->health;
+    for (uint8_t s = 0; s < 2; s++) {
+        out->sensor[s].zero_run = data->health_acc[s].zero_run;
+    }
+    return true;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+bool p2sm_adaptive_get(const uint8_t inst, struct p2sm_adaptive *out) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+    const k_spinlock_key_t key = k_spin_lock(&data->adapt_lock);
+    *out = data->adapt;
+    k_spin_unlock(&data->adapt_lock, key);
+    return true;
 }
 
-void p2sm_toggle_twist() {
-    struct zip_pointer_2s_mixer_data *data = p2sm_data();
+void p2sm_adaptive_reset(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
     if (!data) return;
-    data->twist_enabled = !data->twist_enabled;
+    const k_spinlock_key_t key = k_spin_lock(&data->adapt_lock);
+    memset(&data->adapt, 0, sizeof(data->adapt));
+    k_spin_unlock(&data->adapt_lock, key);
+#if IS_ENABLED(CONFIG_SETTINGS)
+    k_work_reschedule(&data->adapt_save_work, K_MSEC(CONFIG_POINTER_2S_MIXER_SETTINGS_SAVE_DELAY));
+#endif
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+bool p2sm_queue_get_stats(const uint8_t inst, struct p2sm_queue_stats *out) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return false;
+    out->size = CONFIG_POINTER_2S_MIXER_QUEUE_SIZE;
+    out->used = (uint16_t) ((uint32_t) atomic_get(&data->queue_head) - (uint32_t) atomic_get(&data->queue_tail));
+    out->high_water = data->queue_hwm;
+    out->dropped = data->queue_dropped;
+    out->batches = data->queue_batches;
+    return true;
 }
 
-bool p2sm_sma_enabled() {
-    const struct zip_pointer_2s_mixer_data *data = p2sm_data();
-    return data ? data->sma_enabled : false;
+// races with the threads that count, at worst one count survives the reset
+void p2sm_queue_reset_stats(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    data->queue_hwm = 0;
+    data->queue_dropped = 0;
+    data->queue_batches = 0;
 }
+#endif
 
-void p2sm_set_sma_enabled(const bool enabled) {
-    struct zip_pointer_2s_mixer_data *data = p2sm_data();
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+void p2sm_capture_start(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
     if (!data) return;
-    data->sma_enabled = enabled;
-    P2SM_PERSIST();
+    data->capture_active = true;
 }
 
-uint8_t p2sm_get_sma_window() {
-    const struct zip_pointer_2s_mixer_data *data = p2sm_data();
-    return data ? data->sma_window_size : 0;
+void p2sm_capture_stop(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data) return;
+    data->capture_active = false;
 }
 
-void p2sm_set_sma_window(const uint8_t window_size) {
-    struct zip_pointer_2s_mixer_data *data = p2sm_data();
+void p2sm_capture_clear(const uint8_t inst) {
+    struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
     if (!data) return;
-    data->sma_window_size = window_size > CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX ? CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX : window_size;
-    data->sma_head_index = 0;
-    data->sma_count = 0;
-    P2SM_PERSIST();
+    data->capture_head = 0;
+    data->capture_count = 0;
+    data->capture_dropped = 0;
+}
+
+bool p2sm_capture_active(const uint8_t inst) {
+    const struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? data->capture_active : false;
+}
+
+uint16_t p2sm_capture_count(const uint8_t inst) {
+    const struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? data->capture_count : 0;
+}
+
+uint32_t p2sm_capture_dropped(const uint8_t inst) {
+    const struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    return data ? data->capture_dropped : 0;
+}
+
+// oldest first; only consistent while capture is stopped
+bool p2sm_capture_get(const uint8_t inst, const uint16_t idx, struct p2sm_capture_rec *out) {
+    const struct zip_pointer_2s_mixer_data *data = p2sm_data(inst);
+    if (!data || idx >= data->capture_count) return false;
+    const uint16_t start = (data->capture_head + CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE - data->capture_count) % CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE;
+    *out = data->capture_buf[(start + idx) % CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE];
+    return true;
 }
+#endif
 
 #if IS_ENABLED(CONFIG_SETTINGS)
 // ReSharper disable once CppParameterMayBeConst
 static int p2sm_settings_load_cb(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg) {
+    // "<inst>/<key>" for instances other than 0
+    uint8_t inst = 0;
+    const char *next_name;
+    if (name[0] >= '0' && name[0] <= '9' && settings_name_next(name, &next_name) > 0 && next_name != NULL) {
+        inst = (uint8_t) strtoul(name, NULL, 10);
+        name = next_name;
+    }
+
+    if (inst >= P2SM_NUM_INST) {
+        return 0;
+    }
+
+    // params do not depend on data_init(), so lazy init is fine here
+    struct zip_pointer_2s_mixer_data *data = g_instances[inst];
+
     if (settings_name_steq(name, "twist_reversed", NULL)) {
         bool reverse = false;
         const int rd = read_cb(cb_arg, &reverse, sizeof(reverse));
         if (rd == sizeof(bool)) {
-            p2sm_toggle_twist_set_reversed(reverse);
+            p2sm_toggle_twist_set_reversed(data, reverse);
         } else {
             LOG_ERR("Failed to load twist reversed");
         }
@@ -972,10 +3515,7 @@ static int p2sm_settings_load_cb(const char *name, size_t len, settings_read_cb
         bool sma_en = false;
         const int rd = read_cb(cb_arg, &sma_en, sizeof(sma_en));
         if (rd == sizeof(bool)) {
-            if (g_dev != NULL) {
-                struct zip_pointer_2s_mixer_data *data = g_dev->data;
-                data->sma_enabled = sma_en;
-            }
+            p2sm_set_sma_enabled_nosave(data, sma_en);
         } else {
             LOG_ERR("Failed to load sma_en");
         }
@@ -983,14 +3523,37 @@ static int p2sm_settings_load_cb(const char *name, size_t len, settings_read_cb
         return 0;
     }
 
+    if (settings_name_steq(name, "smooth", NULL)) {
+        uint8_t mode = P2SM_SMOOTH_OFF;
+        const int rd = read_cb(cb_arg, &mode, sizeof(mode));
+        if (rd == sizeof(uint8_t)) {
+            p2sm_set_smooth_mode_nosave(data, (enum p2sm_smooth_mode) mode);
+        } else {
+            LOG_ERR("Failed to load smooth");
+        }
+
+        return 0;
+    }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    if (settings_name_steq(name, "twist_est", NULL)) {
+        uint8_t est = P2SM_TWIST_HEURISTIC;
+        const int rd = read_cb(cb_arg, &est, sizeof(est));
+        if (rd == sizeof(uint8_t)) {
+            p2sm_set_twist_estimator_nosave(data, (enum p2sm_twist_estimator) est);
+        } else {
+            LOG_ERR("Failed to load twist_est");
+        }
+
+        return 0;
+    }
+#endif
+
     if (settings_name_steq(name, "sma_win", NULL)) {
         uint8_t sma_win = CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE;
         const int rd = read_cb(cb_arg, &sma_win, sizeof(sma_win));
         if (rd == sizeof(uint8_t)) {
-            if (g_dev != NULL) {
-                struct zip_pointer_2s_mixer_data *data = g_dev->data;
-                data->sma_window_size = sma_win > CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX ? CONFIG_POINTER_2S_MIXER_SMA_WINDOW_SIZE_MAX : sma_win;
-            }
+            p2sm_set_sma_window_nosave(data, sma_win);
         } else {
             LOG_ERR("Failed to load sma_win");
         }
@@ -998,22 +3561,88 @@ static int p2sm_settings_load_cb(const char *name, size_t len, settings_read_cb
         return 0;
     }
 
+    if (settings_name_steq(name, "pred_en", NULL)) {
+        bool pred_en = false;
+        const int rd = read_cb(cb_arg, &pred_en, sizeof(pred_en));
+        if (rd == sizeof(bool)) {
+            p2sm_set_predict_enabled_nosave(data, pred_en);
+        } else {
+            LOG_ERR("Failed to load pred_en");
+        }
+
+        return 0;
+    }
+
+    if (settings_name_steq(name, "accel", NULL)) {
+        uint8_t curve = P2SM_ACCEL_OFF;
+        const int rd = read_cb(cb_arg, &curve, sizeof(curve));
+        if (rd == sizeof(uint8_t)) {
+            p2sm_set_accel_curve_nosave(data, (enum p2sm_accel_curve) curve);
+        } else if (rd != 0) {
+            LOG_ERR("Failed to load accel");
+        }
+
+        return 0;
+    }
+
+    if (settings_name_steq(name, "accel_pts", NULL)) {
+        struct p2sm_accel_point points[P2SM_ACCEL_MAX_POINTS];
+        const int rd = read_cb(cb_arg, points, sizeof(points));
+        if (rd == 0) {
+            return 0;
+        }
+        if (rd < 0 || rd % sizeof(points[0]) != 0 ||
+            p2sm_set_accel_points_nosave(data, points, rd / sizeof(points[0])) != 0) {
+            LOG_ERR("Failed to load accel_pts");
+        }
+
+        return 0;
+    }
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+    if (settings_name_steq(name, "adapt", NULL)) {
+        uint8_t blob[P2SM_ADAPT_BLOB_SIZE];
+        struct p2sm_adaptive adapt;
+        const int rd = read_cb(cb_arg, blob, sizeof(blob));
+        if (len == sizeof(blob) && rd == sizeof(blob) && adapt_unpack(blob, &adapt)) {
+            const k_spinlock_key_t key = k_spin_lock(&data->adapt_lock);
+            data->adapt = adapt;
+            data->adapt_saved[0] = adapt.twist_thres;
+            data->adapt_saved[1] = adapt.interference;
+            k_spin_unlock(&data->adapt_lock, key);
+        } else if (rd != 0) {
+            LOG_WRN("Dropped saved adapt of another layout, learning again");
+        }
+
+        return 0;
+    }
+#endif
+
+    if (settings_name_steq(name, "geom", NULL)) {
+        float geom[2][2][2];
+        const int rd = read_cb(cb_arg, geom, sizeof(geom));
+        if (rd == sizeof(geom)) {
+            p2sm_set_geometry_nosave(data, geom);
+        } else if (rd != 0) {
+            LOG_ERR("Failed to load geom");
+        }
+
+        return 0;
+    }
+
     if (!settings_name_steq(name, "global", NULL)) {
         return 0;
     }
 
-    const int err = read_cb(cb_arg, g_from_settings, sizeof(g_from_settings));
+    float values[2];
+    const int err = read_cb(cb_arg, values, sizeof(values));
     if (err < 0) {
         LOG_ERR("Failed to load settings (err = %d)", err);
     } else {
-        if (g_dev == NULL) {
-            LOG_ERR("Device not initialized!");
-            return -EBUSY;
-        }
-
-        struct zip_pointer_2s_mixer_data *data = g_dev->data;
-        data->move_coef = g_from_settings[0];
-        data->twist_coef = g_from_settings[1];
+        struct p2sm_params *next = params_begin(data);
+        next->move_coef = P2SM_FROM_FLOAT(values[0]);
+        next->twist_coef = P2SM_FROM_FLOAT(values[1]);
+        params_publish(data, next);
     }
     
     return err;
@@ -1048,6 +3677,22 @@ static const struct zrc_param_def {
     { "p2sm/fb_thres",         CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_THRESHOLD, 0, 5000 },
     { "p2sm/fb_dur",           CONFIG_POINTER_2S_MIXER_TWIST_FEEDBACK_DURATION, 0, 5000 },
     { "p2sm/frame_sync",       IS_ENABLED(CONFIG_POINTER_2S_MIXER_FRAME_SYNC), 0, 1 },
+    { "p2sm/pred_horizon",     CONFIG_POINTER_2S_MIXER_PREDICT_HORIZON_US, 0, 16000 },
+    { "p2sm/pred_alpha",       CONFIG_POINTER_2S_MIXER_PREDICT_ALPHA, 1, 100 },
+    { "p2sm/pred_max",         CONFIG_POINTER_2S_MIXER_PREDICT_MAX, 0, 127 },
+    { "p2sm/oe_min_cut",       CONFIG_POINTER_2S_MIXER_ONE_EURO_MIN_CUTOFF, 1, 10000 },
+    { "p2sm/oe_beta",          CONFIG_POINTER_2S_MIXER_ONE_EURO_BETA, 0, 10000 },
+    { "p2sm/oe_d_cut",         CONFIG_POINTER_2S_MIXER_ONE_EURO_D_CUTOFF, 1, 10000 },
+    { "p2sm/accel_top",        CONFIG_POINTER_2S_MIXER_ACCEL_TOP, 10, 10000 },
+    { "p2sm/accel_gain",       CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_GAIN, 10, 1000 },
+    { "p2sm/accel_mid",        CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_MID, 0, 10000 },
+    { "p2sm/accel_width",      CONFIG_POINTER_2S_MIXER_ACCEL_SIGMOID_WIDTH, 1, 10000 },
+    { "p2sm/s1_scale",         100, 25, 400 },
+    { "p2sm/s2_scale",         100, 25, 400 },
+    { "p2sm/s1_trim",          0, -450, 450 },
+    { "p2sm/s2_trim",          0, -450, 450 },
+    { "p2sm/s1_flip",          0, 0, 3 },
+    { "p2sm/s2_flip",          0, 0, 3 },
 };
 
 static int p2sm_register_runtime_params(void) {
@@ -1060,17 +3705,43 @@ static int p2sm_register_runtime_params(void) {
 SYS_INIT(p2sm_register_runtime_params, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
 #endif /* CONFIG_ZMK_RUNTIME_CONFIG */
 
-static struct zip_pointer_2s_mixer_data data = {};
-static struct zip_pointer_2s_mixer_config config = {
-    .sync_report_ms = DT_INST_PROP(0, sync_report_ms),
-    .sync_scroll_report_ms = DT_INST_PROP(0, sync_scroll_report_ms),
-    .twist_interference_thres = DT_INST_PROP(0, twist_interference_thres),
-    .twist_interference_window = DT_INST_PROP_OR(0, twist_interference_window, 0),
-    .sensor1_pos = DT_INST_PROP(0, sensor1_pos),
-    .sensor2_pos = DT_INST_PROP(0, sensor2_pos),
-    .ball_radius = DT_INST_PROP(0, ball_radius),
-    .feedback_gpios = GPIO_DT_SPEC_INST_GET_OR(0, feedback_gpios, { .port = NULL }),
-    .feedback_extra_gpios = GPIO_DT_SPEC_INST_GET_OR(0, feedback_extra_gpios, { .port = NULL }),
-    .twist_feedback_delay = DT_INST_PROP_OR(0, twist_feedback_delay, 0),
+// the ms properties used to be compared with ">" at ms resolution, i.e. the
+// effective spacing was one ms longer than configured; keep it that way
+#define P2SM_SYNC_MS_TO_US(ms) (((ms) + 1) * USEC_PER_MSEC)
+
+#define P2SM_MIXER_INST(n)                                                                            \
+    static struct zip_pointer_2s_mixer_data zip_pointer_2s_mixer_data_##n = {};                        \
+    static const struct zip_pointer_2s_mixer_config zip_pointer_2s_mixer_config_##n = {               \
+        .inst = n,                                                                                    \
+        .sync_report_us = DT_INST_PROP_OR(n, sync_report_us,                                          \
+            P2SM_SYNC_MS_TO_US(DT_INST_PROP(n, sync_report_ms))),                                     \
+        .sync_scroll_report_us = DT_INST_PROP_OR(n, sync_scroll_report_us,                            \
+            P2SM_SYNC_MS_TO_US(DT_INST_PROP(n, sync_scroll_report_ms))),                              \
+        .twist_interference_thres = DT_INST_PROP(n, twist_interference_thres),                        \
+        .twist_interference_window = DT_INST_PROP_OR(n, twist_interference_window, 0),                \
+        .sensor1_pos = DT_INST_PROP(n, sensor1_pos),                                                  \
+        .sensor2_pos = DT_INST_PROP(n, sensor2_pos),                                                  \
+        .ball_radius = DT_INST_PROP(n, ball_radius),                                                  \
+        .sensor_scale = { DT_INST_PROP_OR(n, sensor1_scale, 100), DT_INST_PROP_OR(n, sensor2_scale, 100) }, \
+        .sensor_trim = { DT_INST_PROP_OR(n, sensor1_trim, 0), DT_INST_PROP_OR(n, sensor2_trim, 0) },  \
+        .sensor_flip = { DT_INST_PROP_OR(n, sensor1_flip, 0), DT_INST_PROP_OR(n, sensor2_flip, 0) },  \
+        .feedback_gpios = GPIO_DT_SPEC_INST_GET_OR(n, feedback_gpios, { .port = NULL }),              \
+        .feedback_extra_gpios = GPIO_DT_SPEC_INST_GET_OR(n, feedback_extra_gpios, { .port = NULL }),  \
+        .twist_feedback_delay = DT_INST_PROP_OR(n, twist_feedback_delay, 0),                          \
+        .accel_curve = DT_INST_PROP_OR(n, accel_curve, 0),                                            \
+        .accel_npoints = DT_INST_PROP_LEN_OR(n, accel_points, 0) / 2,                                 \
+        .accel_points = DT_INST_PROP_OR(n, accel_points, {0}),                                        \
+    };                                                                                                \
+    BUILD_ASSERT(DT_INST_PROP_LEN_OR(n, accel_points, 0) <= 2 * P2SM_ACCEL_MAX_POINTS &&              \
+                 DT_INST_PROP_LEN_OR(n, accel_points, 0) % 2 == 0,                                     \
+                 "accel-points: up to " STRINGIFY(P2SM_ACCEL_MAX_POINTS) " <speed gain> pairs");     \
+    DEVICE_DT_INST_DEFINE(n, &sy_init, NULL, &zip_pointer_2s_mixer_data_##n,                          \
+        &zip_pointer_2s_mixer_config_##n, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &sy_driver_api);
+
+DT_INST_FOREACH_STATUS_OKAY(P2SM_MIXER_INST)
+
+// index = devicetree instance number, as used by the runtime API
+#define P2SM_MIXER_INST_DATA(n) &zip_pointer_2s_mixer_data_##n,
+static struct zip_pointer_2s_mixer_data *const g_instances[P2SM_NUM_INST] = {
+    DT_INST_FOREACH_STATUS_OKAY(P2SM_MIXER_INST_DATA)
 };
-DEVICE_DT_INST_DEFINE(0, &sy_init, NULL, &data, &config, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &sy_driver_api);
@@ -20,6 +20,9 @@ do { \
     shell_print((_sh), _fmt, ##__VA_ARGS__); \
 } while (0)
 
+// mixer instance the current command applies to, see cmd_p2sm()
+static uint8_t g_inst = 0;
+
 #define SMALL_BUF_LEN 12
 static __noinline char* ftoi(const float num) {
     const int32_t int_part = (int32_t) (num * 100);
@@ -49,7 +52,7 @@ static int cmd_sens(const struct shell *sh, const size_t argc, char **argv) {
     }
 
     if (strcmp(argv[2], "get") == 0) {
-        const float val = is_pointer ? p2sm_get_move_coef() : p2sm_get_twist_coef();
+        const float val = is_pointer ? p2sm_get_move_coef(g_inst) : p2sm_get_twist_coef(g_inst);
         shprint(sh, "%d (%s)", (int) (val * 1000), ftoi(val));
     } else if (strcmp(argv[2], "set") == 0) {
         if (argc < 4) {
@@ -66,12 +69,12 @@ static int cmd_sens(const struct shell *sh, const size_t argc, char **argv) {
         const uint16_t parsed = (uint16_t)raw_parsed;
 
         if (is_pointer) {
-            p2sm_set_move_coef((float) parsed / 1000);
+            p2sm_set_move_coef(g_inst, (float) parsed / 1000);
         } else {
-            p2sm_set_twist_coef((float) parsed / 1000);
+            p2sm_set_twist_coef(g_inst, (float) parsed / 1000);
         }
 
-        const float val = is_pointer ? p2sm_get_move_coef() : p2sm_get_twist_coef();
+        const float val = is_pointer ? p2sm_get_move_coef(g_inst) : p2sm_get_twist_coef(g_inst);
         shprint(sh, "Set: %d (%s)", (int) (val * 1000), ftoi(val));
     } else {
         shprint(sh, "Usage: p2sm sens <pointer|twist> <get|set> [value]\n");
@@ -87,15 +90,15 @@ static int cmd_twist(const struct shell *sh, const size_t argc, char **argv) {
         return -EINVAL;
     }
 
-    const bool en = p2sm_twist_enabled();
+    const bool en = p2sm_twist_enabled(g_inst);
     if (strcmp(argv[1], "on") == 0) {
-        if (!en) p2sm_toggle_twist();
+        if (!en) p2sm_toggle_twist(g_inst);
     } else if (strcmp(argv[1], "off") == 0) {
-        if (en) p2sm_toggle_twist();
+        if (en) p2sm_toggle_twist(g_inst);
     } else if (strcmp(argv[1], "toggle") == 0) {
-        p2sm_toggle_twist();
+        p2sm_toggle_twist(g_inst);
     } else if (strcmp(argv[1], "reverse") == 0) {
-        p2sm_toggle_twist_reverse();
+        p2sm_toggle_twist_reverse(g_inst);
     } else {
         shprint(sh, "Usage: p2sm twist <on|off|toggle|reverse>\n");
         return -EINVAL;
@@ -111,7 +114,7 @@ static int cmd_sma(const struct shell *sh, const size_t argc, char **argv) {
     }
 
     if (strcmp(argv[1], "get") == 0) {
-        shprint(sh, "%s", p2sm_sma_enabled() ? "enabled" : "disabled");
+        shprint(sh, "%s", p2sm_sma_enabled(g_inst) ? "enabled" : "disabled");
     } else if (strcmp(argv[1], "set") == 0) {
         if (argc < 3) {
             shprint(sh, "Usage: p2sm sma set <0|1>\n");
@@ -125,26 +128,26 @@ static int cmd_sma(const struct shell *sh, const size_t argc, char **argv) {
             return -EINVAL;
         }
         const uint8_t val = (uint8_t)(raw_val != 0);
-        p2sm_set_sma_enabled(val != 0);
-        shprint(sh, "Set: %s", p2sm_sma_enabled() ? "enabled" : "disabled");
+        p2sm_set_sma_enabled(g_inst, val != 0);
+        shprint(sh, "Set: %s", p2sm_sma_enabled(g_inst) ? "enabled" : "disabled");
     } else if (strcmp(argv[1], "on") == 0) {
-        p2sm_set_sma_enabled(true);
-        shprint(sh, "Set: %s", p2sm_sma_enabled() ? "enabled" : "disabled");
+        p2sm_set_sma_enabled(g_inst, true);
+        shprint(sh, "Set: %s", p2sm_sma_enabled(g_inst) ? "enabled" : "disabled");
     } else if (strcmp(argv[1], "off") == 0) {
-        p2sm_set_sma_enabled(false);
-        shprint(sh, "Set: %s", p2sm_sma_enabled() ? "enabled" : "disabled");
+        p2sm_set_sma_enabled(g_inst, false);
+        shprint(sh, "Set: %s", p2sm_sma_enabled(g_inst) ? "enabled" : "disabled");
     } else if (strcmp(argv[1], "toggle") == 0) {
-        const bool current = p2sm_sma_enabled();
-        p2sm_set_sma_enabled(!current);
-        shprint(sh, "Set: %s", p2sm_sma_enabled() ? "enabled" : "disabled");
+        const bool current = p2sm_sma_enabled(g_inst);
+        p2sm_set_sma_enabled(g_inst, !current);
+        shprint(sh, "Set: %s", p2sm_sma_enabled(g_inst) ? "enabled" : "disabled");
     } else if (strcmp(argv[1], "window") == 0) {
         if (argc < 3) {
-            shprint(sh, "Window size: %d", p2sm_get_sma_window());
+            shprint(sh, "Window size: %d", p2sm_get_sma_window(g_inst));
             return 0;
         }
         
         if (strcmp(argv[2], "get") == 0) {
-            shprint(sh, "Window size: %d", p2sm_get_sma_window());
+            shprint(sh, "Window size: %d", p2sm_get_sma_window(g_inst));
         } else if (strcmp(argv[2], "set") == 0) {
             if (argc < 4) {
                 shprint(sh, "Usage: p2sm sma window set <1-255>\n");
@@ -157,8 +160,8 @@ static int cmd_sma(const struct shell *sh, const size_t argc, char **argv) {
                 return -EINVAL;
             }
             const uint8_t val = (uint8_t)raw_window;
-            p2sm_set_sma_window(val);
-            shprint(sh, "Window size set to: %d", p2sm_get_sma_window());
+            p2sm_set_sma_window(g_inst, val);
+            shprint(sh, "Window size set to: %d", p2sm_get_sma_window(g_inst));
         } else {
             shprint(sh, "Usage: p2sm sma window <get|set>\n");
             return -EINVAL;
@@ -171,17 +174,517 @@ static int cmd_sma(const struct shell *sh, const size_t argc, char **argv) {
     return 0;
 }
 
+static const char *const smooth_names[P2SM_SMOOTH_COUNT] = {
+    [P2SM_SMOOTH_OFF] = "off",
+    [P2SM_SMOOTH_SMA] = "sma",
+    [P2SM_SMOOTH_ONE_EURO] = "1euro",
+};
+
+static int cmd_smooth(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc < 2) {
+        shprint(sh, "Usage: p2sm smooth <get|off|sma|1euro>\n");
+        return -EINVAL;
+    }
+
+    if (strcmp(argv[1], "get") != 0) {
+        size_t mode = 0;
+        while (mode < P2SM_SMOOTH_COUNT && strcmp(argv[1], smooth_names[mode]) != 0) {
+            mode++;
+        }
+        if (mode == P2SM_SMOOTH_COUNT) {
+            shprint(sh, "Usage: p2sm smooth <get|off|sma|1euro>\n");
+            return -EINVAL;
+        }
+        p2sm_set_smooth_mode(g_inst, (enum p2sm_smooth_mode) mode);
+    }
+
+    struct p2sm_one_euro_config cfg;
+    if (!p2sm_one_euro_get_config(g_inst, &cfg)) {
+        return -ENODEV;
+    }
+    shprint(sh, "Smoothing: %s", smooth_names[p2sm_get_smooth_mode(g_inst)]);
+    shprint(sh, "SMA window: %d", p2sm_get_sma_window(g_inst));
+    // runtime config keys p2sm/oe_min_cut, p2sm/oe_beta, p2sm/oe_d_cut
+    shprint(sh, "1euro: min cutoff %d.%d Hz, beta %d.%d Hz per count/ms, speed cutoff %d.%d Hz",
+            cfg.min_cutoff / 10, cfg.min_cutoff % 10, cfg.beta / 10, cfg.beta % 10, cfg.d_cutoff / 10, cfg.d_cutoff % 10);
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+static const char *const estimator_names[P2SM_TWIST_COUNT] = {
+    [P2SM_TWIST_HEURISTIC] = "heuristic",
+    [P2SM_TWIST_RIGID] = "rigid",
+};
+
+static int cmd_estimator(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc < 2) {
+        shprint(sh, "Usage: p2sm estimator <get|heuristic|rigid>\n");
+        return -EINVAL;
+    }
+
+    if (strcmp(argv[1], "get") != 0) {
+        size_t est = 0;
+        while (est < P2SM_TWIST_COUNT && strcmp(argv[1], estimator_names[est]) != 0) {
+            est++;
+        }
+        if (est == P2SM_TWIST_COUNT) {
+            shprint(sh, "Usage: p2sm estimator <get|heuristic|rigid>\n");
+            return -EINVAL;
+        }
+        p2sm_set_twist_estimator(g_inst, (enum p2sm_twist_estimator) est);
+    }
+
+    shprint(sh, "Twist estimator: %s", estimator_names[p2sm_get_twist_estimator(g_inst)]);
+    return 0;
+}
+#endif
+
+static int cmd_predict(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc < 2) {
+        shprint(sh, "Usage: p2sm predict <get|on|off|toggle>\n");
+        return -EINVAL;
+    }
+
+    if (strcmp(argv[1], "on") == 0) {
+        p2sm_set_predict_enabled(g_inst, true);
+    } else if (strcmp(argv[1], "off") == 0) {
+        p2sm_set_predict_enabled(g_inst, false);
+    } else if (strcmp(argv[1], "toggle") == 0) {
+        p2sm_set_predict_enabled(g_inst, !p2sm_predict_enabled(g_inst));
+    } else if (strcmp(argv[1], "get") != 0) {
+        shprint(sh, "Usage: p2sm predict <get|on|off|toggle>\n");
+        return -EINVAL;
+    }
+
+    struct p2sm_predict_config cfg;
+    if (!p2sm_predict_get_config(g_inst, &cfg)) {
+        return -ENODEV;
+    }
+    shprint(sh, "Prediction: %s", p2sm_predict_enabled(g_inst) ? "enabled" : "disabled");
+    // tunables are runtime config keys p2sm/pred_horizon, p2sm/pred_alpha, p2sm/pred_max
+    shprint(sh, "Horizon: %d us, alpha: %d%%, max lead: %d", cfg.horizon_us, cfg.alpha, cfg.max_lead);
+    return 0;
+}
+
+static const char *const accel_names[P2SM_ACCEL_COUNT] = {
+    [P2SM_ACCEL_OFF] = "off",
+    [P2SM_ACCEL_POINTS] = "points",
+    [P2SM_ACCEL_SIGMOID] = "sigmoid",
+};
+
+// "<speed>:<gain>", speed in 0.1 counts/ms, gain in %
+static bool parse_accel_point(const char *arg, struct p2sm_accel_point *out) {
+    char *endptr;
+    const unsigned long speed = strtoul(arg, &endptr, 10);
+    if (endptr == arg || *endptr != ':' || speed > UINT16_MAX) {
+        return false;
+    }
+    const char *gain_str = endptr + 1;
+    const unsigned long gain = strtoul(gain_str, &endptr, 10);
+    if (endptr == gain_str || *endptr != '\0' || gain > UINT16_MAX) {
+        return false;
+    }
+    out->speed = (uint16_t) speed;
+    out->gain = (uint16_t) gain;
+    return true;
+}
+
+static int cmd_accel(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc < 2) {
+        shprint(sh, "Usage: p2sm accel <get|off|sigmoid|points [<speed>:<gain> ...]>\n");
+        return -EINVAL;
+    }
+
+    if (strcmp(argv[1], "points") == 0 && argc > 2) {
+        struct p2sm_accel_point points[P2SM_ACCEL_MAX_POINTS];
+        const size_t n = argc - 2;
+        if (n > P2SM_ACCEL_MAX_POINTS) {
+            shprint(sh, "Error: at most %d points", P2SM_ACCEL_MAX_POINTS);
+            return -EINVAL;
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (!parse_accel_point(argv[i + 2], &points[i])) {
+                shprint(sh, "Error: invalid point '%s', expected <speed>:<gain>", argv[i + 2]);
+                return -EINVAL;
+            }
+        }
+        if (p2sm_set_accel_points(g_inst, points, (uint8_t) n) != 0) {
+            shprint(sh, "Error: speeds must be ascending");
+            return -EINVAL;
+        }
+    }
+
+    if (strcmp(argv[1], "get") != 0) {
+        size_t curve = 0;
+        while (curve < P2SM_ACCEL_COUNT && strcmp(argv[1], accel_names[curve]) != 0) {
+            curve++;
+        }
+        if (curve == P2SM_ACCEL_COUNT) {
+            shprint(sh, "Usage: p2sm accel <get|off|sigmoid|points [<speed>:<gain> ...]>\n");
+            return -EINVAL;
+        }
+        p2sm_set_accel_curve(g_inst, (enum p2sm_accel_curve) curve);
+    }
+
+    struct p2sm_accel_config cfg;
+    if (!p2sm_accel_get_config(g_inst, &cfg)) {
+        return -ENODEV;
+    }
+    shprint(sh, "Acceleration: %s", accel_names[cfg.curve]);
+    // speeds are 0.1 counts/ms; top and sigmoid are runtime config keys p2sm/accel_*
+    for (uint8_t i = 0; i < cfg.num_points; i++) {
+        shprint(sh, "  point %d: %d.%d counts/ms -> %d%%", i, cfg.points[i].speed / 10, cfg.points[i].speed % 10,
+                cfg.points[i].gain);
+    }
+    shprint(sh, "Sigmoid: %d%% at high speed, mid %d.%d counts/ms, width %d.%d counts/ms", cfg.sigmoid_gain,
+            cfg.sigmoid_mid / 10, cfg.sigmoid_mid % 10, cfg.sigmoid_width / 10, cfg.sigmoid_width % 10);
+    shprint(sh, "Gain at 0/25/50/75/100%% of %d.%d counts/ms: %d/%d/%d/%d/%d%%", cfg.top / 10, cfg.top % 10,
+            p2sm_accel_gain_at(g_inst, 0), p2sm_accel_gain_at(g_inst, cfg.top / 4),
+            p2sm_accel_gain_at(g_inst, cfg.top / 2), p2sm_accel_gain_at(g_inst, cfg.top * 3 / 4),
+            p2sm_accel_gain_at(g_inst, cfg.top));
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+static const char *const discard_names[P2SM_DISCARD_COUNT] = {
+    [P2SM_DISCARD_TWIST_THRES] = "twist_thres",
+    [P2SM_DISCARD_SIGNIFICANT_TRANSLATION] = "significant_translation",
+    [P2SM_DISCARD_DIRECTION_FILTER] = "direction_filter",
+    [P2SM_DISCARD_INTERFERENCE] = "interference",
+    [P2SM_DISCARD_DEBOUNCE] = "debounce",
+    [P2SM_DISCARD_TIME_FILTER] = "time_filter",
+    [P2SM_DISCARD_STEADY_COOLDOWN] = "steady_cooldown",
+    [P2SM_DISCARD_HEALTH] = "health",
+};
+
+static const char *const twist_state_names[P2SM_TWIST_STATE_COUNT] = {
+    [P2SM_TWIST_IDLE] = "idle",
+    [P2SM_TWIST_CANDIDATE] = "candidate",
+    [P2SM_TWIST_DEBOUNCING] = "debouncing",
+    [P2SM_TWIST_ACTIVE] = "active",
+    [P2SM_TWIST_COOLDOWN] = "cooldown",
+};
+
+static int cmd_stats(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shprint(sh, "Usage: p2sm stats [reset]\n");
+            return -EINVAL;
+        }
+
+        p2sm_stats_reset(g_inst);
+        shprint(sh, "Done.");
+        return 0;
+    }
+
+    struct p2sm_stats st;
+    if (!p2sm_stats_get(g_inst, &st)) {
+        shprint(sh, "Error: device not initialized");
+        return -ENODEV;
+    }
+
+    shprint(sh, "Events in: %u (frames: %u)", st.events_in, st.frames_in);
+    shprint(sh, "Reports out: %u (wheel: %u, hi-res: %u)", st.reports_out, st.wheel_reports_out,
+            st.wheel_hi_res_reports_out);
+    if (IS_ENABLED(CONFIG_POINTER_2S_MIXER_KINETIC_SCROLL)) {
+        shprint(sh, "Kinetic scroll: %u coasts (%u caught)", st.coasts, st.coast_catches);
+    }
+    shprint(sh, "Sync resets: %u", st.sync_resets);
+    shprint(sh, "Single-sensor fallbacks: %u (resyncs: %u)", st.single_sensor_entries, st.dual_resyncs);
+    shprint(sh, "SMA timeouts: %u", st.sma_timeouts);
+    shprint(sh, "Params updates: %u", st.params_updates);
+    shprint(sh, "Clipped: frame %u, projection %u, twist %u, report %u", st.clipped[P2SM_CLIP_FRAME],
+            st.clipped[P2SM_CLIP_PROJECTION], st.clipped[P2SM_CLIP_TWIST], st.clipped[P2SM_CLIP_REPORT]);
+    shprint(sh, "");
+
+    shprint(sh, "Twist evaluations: %u", st.twist_evals);
+    for (uint8_t i = 0; i < P2SM_DISCARD_COUNT; i++) {
+        shprint(sh, "  %s: %u", discard_names[i], st.twist_discards[i]);
+    }
+    shprint(sh, "Twist transitions:");
+    for (uint8_t i = 0; i < P2SM_TWIST_STATE_COUNT; i++) {
+        for (uint8_t j = 0; j < P2SM_TWIST_STATE_COUNT; j++) {
+            if (st.twist_transitions[i][j] != 0) {
+                shprint(sh, "  %s -> %s: %u", twist_state_names[i], twist_state_names[j], st.twist_transitions[i][j]);
+            }
+        }
+    }
+    shprint(sh, "");
+
+    const uint32_t hz = sys_clock_hw_cycles_per_sec();
+    const uint32_t avg = st.events_in > 0 ? (uint32_t) (st.cycles_total / st.events_in) : 0;
+    shprint(sh, "Cycles per event (%u Hz): avg %u, max %u", hz, avg, st.cycles_max);
+    for (uint8_t i = 0; i < P2SM_STATS_HIST_BUCKETS; i++) {
+        if (st.cycles_hist[i] == 0) {
+            continue;
+        }
+        if (i == P2SM_STATS_HIST_BUCKETS - 1) {
+            shprint(sh, "  >= %u: %u", 1u << i, st.cycles_hist[i]);
+        } else {
+            shprint(sh, "  %u-%u: %u", 1u << i, (2u << i) - 1, st.cycles_hist[i]);
+        }
+    }
+
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+static int cmd_health(const struct shell *sh, const size_t argc, char **argv) {
+    struct p2sm_health h;
+    if (!p2sm_health_get(g_inst, &h)) {
+        shprint(sh, "Error: device not initialized");
+        return -ENODEV;
+    }
+
+    for (uint8_t s = 0; s < 2; s++) {
+        const struct p2sm_health_sensor *hs = &h.sensor[s];
+        shprint(sh, "Sensor %d:%s%s%s%s", s + 1, hs->flags == 0 ? " ok" : "",
+                (hs->flags & P2SM_HEALTH_STALL) ? " stalled" : "", (hs->flags & P2SM_HEALTH_SATURATED) ? " saturated" : "",
+                (hs->flags & P2SM_HEALTH_NOISY) ? " noisy" : "");
+        shprint(sh, "  Rate: %d Hz", hs->rate_hz);
+        shprint(sh, "  Zero run: %d (max %d)", hs->zero_run, hs->max_zero_run);
+        shprint(sh, "  Noise frames: %d, saturations: %u", hs->noise_frames, hs->saturations);
+        shprint(sh, "  |dx|+|dy|: 0:%d 1:%d 2:%d 4:%d 8:%d 16:%d 32:%d 64+:%d", hs->hist[0], hs->hist[1], hs->hist[2],
+                hs->hist[3], hs->hist[4], hs->hist[5], hs->hist[6], hs->hist[7]);
+    }
+    shprint(sh, "Correlation: %d%%", h.correlation);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+static int cmd_adaptive(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shprint(sh, "Usage: p2sm adaptive [reset]\n");
+            return -EINVAL;
+        }
+
+        p2sm_adaptive_reset(g_inst);
+        shprint(sh, "Done.");
+        return 0;
+    }
+
+    struct p2sm_adaptive a;
+    if (!p2sm_adaptive_get(g_inst, &a)) {
+        shprint(sh, "Error: device not initialized");
+        return -ENODEV;
+    }
+
+    // quantiles are in 1/256 counts
+    shprint(sh, "Noise: %d.%02d counts (%u windows)", a.noise / 256, a.noise % 256 * 100 / 256, a.noise_samples);
+    shprint(sh, "Leak: %d.%02d counts (%u windows)", a.leak / 256, a.leak % 256 * 100 / 256, a.leak_samples);
+    if (a.twist_thres != 0) {
+        shprint(sh, "Twist threshold: %u", a.twist_thres);
+    } else {
+        shprint(sh, "Twist threshold: configured");
+    }
+    if (a.interference != 0) {
+        shprint(sh, "Interference threshold: %u", a.interference);
+    } else {
+        shprint(sh, "Interference threshold: configured");
+    }
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+static int cmd_queue(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shprint(sh, "Usage: p2sm queue [reset]\n");
+            return -EINVAL;
+        }
+
+        p2sm_queue_reset_stats(g_inst);
+        shprint(sh, "Done.");
+        return 0;
+    }
+
+    struct p2sm_queue_stats st;
+    if (!p2sm_queue_get_stats(g_inst, &st)) {
+        shprint(sh, "Error: device not initialized");
+        return -ENODEV;
+    }
+
+    shprint(sh, "Queue: %d/%d (high water: %d)", st.used, st.size, st.high_water);
+    shprint(sh, "Dropped: %u", st.dropped);
+    shprint(sh, "Batches: %u", st.batches);
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+#define CAPTURE_RECS_PER_LINE 8
+
+// text-safe dump of the binary records; host/p2sm_replay parses "cap" lines
+static void capture_dump(const struct shell *sh) {
+    const uint16_t count = p2sm_capture_count(g_inst);
+    char line[CAPTURE_RECS_PER_LINE * sizeof(struct p2sm_capture_rec) * 2 + 1];
+    size_t pos = 0;
+
+    shprint(sh, "cap-begin v1 %d %u", count, p2sm_capture_dropped(g_inst));
+    for (uint16_t i = 0; i < count; i++) {
+        struct p2sm_capture_rec rec;
+        if (!p2sm_capture_get(g_inst, i, &rec)) {
+            break;
+        }
+
+        const uint8_t bytes[sizeof(rec)] = {
+            rec.t_us & 0xFF, (rec.t_us >> 8) & 0xFF, (rec.t_us >> 16) & 0xFF, (rec.t_us >> 24) & 0xFF,
+            (uint16_t) rec.value & 0xFF, ((uint16_t) rec.value >> 8) & 0xFF, rec.code, rec.flags,
+        };
+        for (size_t b = 0; b < sizeof(bytes); b++) {
+            pos += snprintf(line + pos, sizeof(line) - pos, "%02x", bytes[b]);
+        }
+
+        if ((i + 1) % CAPTURE_RECS_PER_LINE == 0 || i + 1 == count) {
+            shprint(sh, "cap %s", line);
+            pos = 0;
+        }
+    }
+    shprint(sh, "cap-end");
+}
+
+static int cmd_capture(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc < 2) {
+        shprint(sh, "Usage: p2sm capture <start|stop|clear|status|dump>\n");
+        return -EINVAL;
+    }
+
+    if (strcmp(argv[1], "start") == 0) {
+        p2sm_capture_start(g_inst);
+    } else if (strcmp(argv[1], "stop") == 0) {
+        p2sm_capture_stop(g_inst);
+    } else if (strcmp(argv[1], "clear") == 0) {
+        p2sm_capture_clear(g_inst);
+    } else if (strcmp(argv[1], "status") == 0) {
+        shprint(sh, "Capture: %s", p2sm_capture_active(g_inst) ? "running" : "stopped");
+        shprint(sh, "Records: %d/%d (overwritten: %u)", p2sm_capture_count(g_inst), CONFIG_POINTER_2S_MIXER_CAPTURE_SIZE,
+                p2sm_capture_dropped(g_inst));
+    } else if (strcmp(argv[1], "dump") == 0) {
+        // ring must not move while it is being read
+        p2sm_capture_stop(g_inst);
+        capture_dump(sh);
+    } else {
+        shprint(sh, "Usage: p2sm capture <start|stop|clear|status|dump>\n");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+static void calib_print_phase(const struct shell *sh, const enum p2sm_calib_phase phase) {
+    switch (phase) {
+    case P2SM_CALIB_ROLL_X:
+        shprint(sh, "Roll the ball so the pointer moves right, lift and repeat; then \"p2sm calibrate next\"");
+        break;
+    case P2SM_CALIB_ROLL_Y:
+        shprint(sh, "Roll the ball so the pointer moves down, lift and repeat; then \"p2sm calibrate next\"");
+        break;
+    case P2SM_CALIB_TWIST:
+        shprint(sh, "Twist the ball around its vertical axis (optional); then \"p2sm calibrate next\"");
+        break;
+    default:
+        break;
+    }
+}
+
+// thousandths, the shell has no float formatting
+static void calib_print_result(const struct shell *sh, const struct p2sm_calib_result *res) {
+    for (uint8_t s = 0; s < 2; s++) {
+        shprint(sh, "Sensor %d: [%d %d; %d %d] /1000, error %d%%", s + 1,
+                (int) (res->matrix[s][0][0] * 1000), (int) (res->matrix[s][0][1] * 1000),
+                (int) (res->matrix[s][1][0] * 1000), (int) (res->matrix[s][1][1] * 1000),
+                (int) (res->error[s] * 100));
+    }
+}
+
+static int cmd_calibrate(const struct shell *sh, const size_t argc, char **argv) {
+    if (argc < 2) {
+        shprint(sh, "Usage: p2sm calibrate <start|next|status|abort|apply|reset>\n");
+        return -EINVAL;
+    }
+
+    if (strcmp(argv[1], "start") == 0) {
+        p2sm_calib_start(g_inst);
+        calib_print_phase(sh, P2SM_CALIB_ROLL_X);
+    } else if (strcmp(argv[1], "next") == 0) {
+        p2sm_calib_next(g_inst);
+        struct p2sm_calib_status st;
+        if (!p2sm_calib_get_status(g_inst, &st)) {
+            return -ENODEV;
+        }
+        if (st.phase != P2SM_CALIB_DONE) {
+            calib_print_phase(sh, st.phase);
+            return 0;
+        }
+
+        struct p2sm_calib_result res;
+        const int err = p2sm_calib_solve(g_inst, &res);
+        if (err == -EAGAIN) {
+            shprint(sh, "Not enough samples (%u/%u, need %d each), start over", st.samples[0], st.samples[1],
+                    CONFIG_POINTER_2S_MIXER_CALIBRATION_MIN_SAMPLES);
+            return err;
+        } else if (err == -EDOM) {
+            shprint(sh, "Rolls along X and Y look the same to a sensor, start over");
+            return err;
+        } else if (err != 0) {
+            return err;
+        }
+        calib_print_result(sh, &res);
+        shprint(sh, "\"p2sm calibrate apply\" to use it");
+    } else if (strcmp(argv[1], "status") == 0) {
+        struct p2sm_calib_status st;
+        if (!p2sm_calib_get_status(g_inst, &st)) {
+            return -ENODEV;
+        }
+        static const char *const phase_names[] = { "idle", "roll X", "roll Y", "twist", "done" };
+        shprint(sh, "Phase: %s", phase_names[st.phase]);
+        shprint(sh, "Samples: X %u, Y %u, twist %u", st.samples[0], st.samples[1], st.samples[2]);
+        shprint(sh, "Geometry: %s", p2sm_geometry_is_fitted(g_inst) ? "fitted" : "devicetree");
+    } else if (strcmp(argv[1], "abort") == 0) {
+        p2sm_calib_abort(g_inst);
+    } else if (strcmp(argv[1], "apply") == 0) {
+        const int err = p2sm_calib_apply(g_inst);
+        if (err != 0) {
+            shprint(sh, "Nothing to apply, finish a calibration first");
+            return err;
+        }
+    } else if (strcmp(argv[1], "reset") == 0) {
+        p2sm_geometry_reset(g_inst);
+    } else {
+        shprint(sh, "Usage: p2sm calibrate <start|next|status|abort|apply|reset>\n");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+#endif
+
 static int cmd_status(const struct shell *sh, const size_t argc, char **argv) {
+    shprint(sh, "Instance: %d of %d", g_inst, p2sm_num_instances());
+    shprint(sh, "");
+
     shprint(sh, "General:");
-    shprint(sh, "Twist scroll: %s", p2sm_twist_enabled() ? "enabled" : "disabled");
-    shprint(sh, "Twist reversed: %s", p2sm_twist_is_reversed() ? "yes" : "no");
-    shprint(sh, "SMA smoothing: %s", p2sm_sma_enabled() ? "enabled" : "disabled");
-    shprint(sh, "SMA window: %d", p2sm_get_sma_window());
+    shprint(sh, "Twist scroll: %s", p2sm_twist_enabled(g_inst) ? "enabled" : "disabled");
+    shprint(sh, "Twist reversed: %s", p2sm_twist_is_reversed(g_inst) ? "yes" : "no");
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    shprint(sh, "Twist estimator: %s", estimator_names[p2sm_get_twist_estimator(g_inst)]);
+#endif
+    shprint(sh, "Smoothing: %s", smooth_names[p2sm_get_smooth_mode(g_inst)]);
+    shprint(sh, "SMA window: %d", p2sm_get_sma_window(g_inst));
+    shprint(sh, "Prediction: %s", p2sm_predict_enabled(g_inst) ? "enabled" : "disabled");
+    shprint(sh, "Acceleration: %s", accel_names[p2sm_get_accel_curve(g_inst)]);
+    shprint(sh, "Geometry: %s", p2sm_geometry_is_fitted(g_inst) ? "fitted" : "devicetree");
     shprint(sh, "");
 
     shprint(sh, "Sensitivity:");
-    shprint(sh, "Pointer: %s", ftoi(p2sm_get_move_coef()));
-    shprint(sh, "Twist scroll: %s", ftoi(p2sm_get_twist_coef()));
+    shprint(sh, "Pointer: %s", ftoi(p2sm_get_move_coef(g_inst)));
+    shprint(sh, "Twist scroll: %s", ftoi(p2sm_get_twist_coef(g_inst)));
     shprint(sh, "");
 
     shprint(sh, "Behaviors:");
@@ -340,9 +843,95 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_p2sm,
     SHELL_CMD(twist, NULL, "Change status of twist scroll", cmd_twist),
     SHELL_CMD(sens, NULL, "Change sensitivity", cmd_sens),
     SHELL_CMD(sma, NULL, "Control SMA smoothing", cmd_sma),
+    SHELL_CMD(smooth, NULL, "Select smoothing mode", cmd_smooth),
+    SHELL_CMD(predict, NULL, "Control motion prediction", cmd_predict),
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+    SHELL_CMD(estimator, NULL, "Select twist estimator", cmd_estimator),
+#endif
+    SHELL_CMD(accel, NULL, "Select pointer acceleration curve", cmd_accel),
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+    SHELL_CMD(calibrate, NULL, "Fit the sensor geometry", cmd_calibrate),
+#endif
     SHELL_CMD(behavior, &sub_behavior, "Manage behaviors", NULL),
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+    SHELL_CMD(stats, NULL, "Show or reset hot path counters", cmd_stats),
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+    SHELL_CMD(health, NULL, "Show sensor health", cmd_health),
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+    SHELL_CMD(adaptive, NULL, "Show or reset learned twist thresholds", cmd_adaptive),
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+    SHELL_CMD(queue, NULL, "Show or reset mixer queue counters", cmd_queue),
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+    SHELL_CMD(capture, NULL, "Capture raw sensor events", cmd_capture),
+#endif
     SHELL_SUBCMD_SET_END
 );
 
-SHELL_CMD_REGISTER(p2sm, &sub_p2sm, "Sensor mixer configuration", NULL);
+// "p2sm -i <n> <command> ..." runs a per-instance command against mixer n,
+// without -i everything applies to instance 0
+static int cmd_p2sm(const struct shell *sh, const size_t argc, char **argv) {
+    static const struct {
+        const char *name;
+        int (*handler)(const struct shell *sh, size_t argc, char **argv);
+    } inst_cmds[] = {
+        { "status", cmd_status },
+        { "twist", cmd_twist },
+        { "sens", cmd_sens },
+        { "sma", cmd_sma },
+        { "smooth", cmd_smooth },
+        { "predict", cmd_predict },
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_RIGID_BODY)
+        { "estimator", cmd_estimator },
+#endif
+        { "accel", cmd_accel },
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CALIBRATION)
+        { "calibrate", cmd_calibrate },
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_STATS)
+        { "stats", cmd_stats },
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_HEALTH)
+        { "health", cmd_health },
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_ADAPTIVE_THRES)
+        { "adaptive", cmd_adaptive },
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_QUEUE)
+        { "queue", cmd_queue },
+#endif
+#if IS_ENABLED(CONFIG_POINTER_2S_MIXER_CAPTURE)
+        { "capture", cmd_capture },
+#endif
+    };
+
+    if (argc < 4 || strcmp(argv[1], "-i") != 0) {
+        shprint(sh, "Usage: p2sm [-i <instance>] <command> ...\n");
+        return -EINVAL;
+    }
+
+    char *endptr;
+    const unsigned long raw_inst = strtoul(argv[2], &endptr, 10);
+    if (endptr == argv[2] || *endptr != '\0' || raw_inst >= p2sm_num_instances()) {
+        shprint(sh, "Error: invalid instance (0-%d)", p2sm_num_instances() - 1);
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(inst_cmds); i++) {
+        if (strcmp(argv[3], inst_cmds[i].name) == 0) {
+            g_inst = (uint8_t) raw_inst;
+            const int ret = inst_cmds[i].handler(sh, argc - 3, argv + 3);
+            g_inst = 0;
+            return ret;
+        }
+    }
+
+    shprint(sh, "Error: %s is not a per-instance command", argv[3]);
+    return -EINVAL;
+}
+
+SHELL_CMD_REGISTER(p2sm, &sub_p2sm, "Sensor mixer configuration", cmd_p2sm);
 #endif